@@ -0,0 +1,294 @@
+"""
+Análise de escalonabilidade offline do app_final a partir dos tempos medidos.
+
+Lê a tabela de tarefas de src/main.c (nome, grupo e macro do período), os
+períodos de include/controlTasks.h, o C máximo de cada tarefa em
+output/task_stats.txt e o tempo de posse de cada trava por tarefa em
+output/lock_stats.txt. Com isso calcula:
+
+- utilização contra o limite de Liu & Layland (RMS) e contra U <= 1 (EDF);
+- tempo de resposta no pior caso de cada tarefa com prioridades fixas RMS e
+  bloqueio pelas travas com herança de prioridade;
+- o teste EDF com bloqueio (Baker) para comparação;
+- os menores períodos inteiros da cadeia de controle (grupo "controle") que
+  ainda passam em cada análise, escalando todos por um mesmo fator.
+
+Uso:
+    python3 displayScripts/response_time_analysis.py [--margem M] [--granularidade G]
+
+Sem --margem, o C de cada tarefa é o WCET medido vezes WCET_MARGIN de main.c,
+o mesmo orçamento usado pelo teste de admissão do app_final.
+"""
+import argparse
+import math
+import os
+import re
+import sys
+
+# Caminho absoluto da pasta onde este script está
+BASE_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.abspath(os.path.join(BASE_DIR, ".."))
+OUTPUT_DIR = os.path.join(REPO_DIR, "output")
+MAIN_SOURCE = os.path.join(REPO_DIR, "src", "main.c")
+TASKS_HEADER = os.path.join(REPO_DIR, "include", "controlTasks.h")
+
+CONTROL_GROUP = "controle"
+# Estágios da cadeia, da referência à planta; estágios paralelos ficam na mesma lista
+CONTROL_CHAIN = [["ref_model_x", "ref_model_y"], ["control"], ["linearization"], ["robot_sim"]]
+
+
+# --- Leitura das Entradas ---
+
+def read_defines(*paths):
+    defines = {}
+    for path in paths:
+        with open(path) as f:
+            for match in re.finditer(r"^#define\s+(\w+)\s+([0-9.]+)", f.read(), re.MULTILINE):
+                defines[match.group(1)] = float(match.group(2))
+    return defines
+
+
+def read_task_table(defines):
+    """Entradas de 'PeriodicTask tasks[]' em main.c: {"nome", GRUPO, PERIODO, ...}."""
+    with open(MAIN_SOURCE) as f:
+        source = f.read()
+    groups = {"GROUP_CONTROL": CONTROL_GROUP, "GROUP_INTERFACE": "interface"}
+    tasks = []
+    for name, group, period in re.findall(r'\{"(\w+)",\s*(\w+),\s*(\w+),', source):
+        if period not in defines:
+            continue
+        tasks.append({"name": name, "group": groups.get(group, group), "period_ms": int(defines[period])})
+    return tasks
+
+
+def read_measured_wcet(path):
+    """C máximo por tarefa em output/task_stats.txt (mesma leitura de load_measured_wcet)."""
+    wcet = {}
+    try:
+        with open(path) as f:
+            header = f.readline().split()
+            for line in f:
+                fields = line.split()
+                if len(fields) == len(header):
+                    row = dict(zip(header, fields))
+                    if float(row["c_max_ms"]) > 0:
+                        wcet[row["tarefa"]] = float(row["c_max_ms"])
+    except FileNotFoundError:
+        pass
+    return wcet
+
+
+def read_lock_holds(path):
+    """{trava: {tarefa: posse máxima em ms}} a partir de output/lock_stats.txt."""
+    holds = {}
+    try:
+        with open(path) as f:
+            header = f.readline().split()
+            for line in f:
+                fields = line.split()
+                if len(fields) == len(header):
+                    row = dict(zip(header, fields))
+                    holds.setdefault(row["trava"], {})[row["tarefa"]] = float(row["posse_max_ms"])
+    except FileNotFoundError:
+        pass
+    return holds
+
+
+# --- Análises ---
+
+def utilization(tasks, periods):
+    return sum(t["c_ms"] / periods[t["name"]] for t in tasks)
+
+
+def liu_layland_bound(n):
+    return n * (2 ** (1.0 / n) - 1)
+
+
+def blocking_terms(tasks, periods, holds):
+    """
+    Bloqueio máximo de cada tarefa com herança de prioridade (travas não aninhadas).
+    Uma tarefa i só é bloqueada por tarefas de período maior e por travas cujo teto
+    (maior prioridade entre as usuárias) é pelo menos o de i; cada trava e cada
+    tarefa de menor prioridade bloqueiam no máximo uma vez: B_i é o menor dos dois
+    somatórios. Com períodos por nível de preempção, o mesmo termo vale para o EDF.
+    """
+    ceilings = {lock: min(periods[u] for u in users if u in periods) for lock, users in holds.items()
+                if any(u in periods for u in users)}
+    blocking = {}
+    for task in tasks:
+        period = periods[task["name"]]
+        locks = [lock for lock, ceiling in ceilings.items() if ceiling <= period]
+        lower = [t["name"] for t in tasks if periods[t["name"]] > period]
+        per_lock = sum(max((holds[lock].get(j, 0.0) for j in lower), default=0.0) for lock in locks)
+        per_task = sum(max((holds[lock].get(j, 0.0) for lock in locks), default=0.0) for j in lower)
+        blocking[task["name"]] = min(per_lock, per_task)
+    return blocking
+
+
+def response_times(tasks, periods, blocking):
+    """
+    R_i = C_i + B_i + soma sobre j com T_j <= T_i, j != i de ceil(R_i / T_j) * C_j.
+    Períodos iguais dividem o nível de prioridade (FIFO dentro do nível) e entram
+    como interferência. Retorna {tarefa: R}, com None quando R passa do deadline.
+    """
+    result = {}
+    for task in tasks:
+        name, c, period = task["name"], task["c_ms"], periods[task["name"]]
+        higher = [t for t in tasks if t["name"] != name and periods[t["name"]] <= period]
+        r = c + blocking[name]
+        while True:
+            nxt = c + blocking[name] + sum(math.ceil(r / periods[t["name"]] - 1e-9) * t["c_ms"] for t in higher)
+            if nxt > period:
+                result[name] = None
+                break
+            if nxt == r:
+                result[name] = r
+                break
+            r = nxt
+    return result
+
+
+def rms_feasible(tasks, periods, holds):
+    return all(r is not None for r in response_times(tasks, periods, blocking_terms(tasks, periods, holds)).values())
+
+
+def edf_feasible(tasks, periods, holds):
+    """Baker: para cada k em ordem de período, soma_{T_i <= T_k} C_i/T_i + B_k/T_k <= 1."""
+    blocking = blocking_terms(tasks, periods, holds)
+    for task in tasks:
+        period = periods[task["name"]]
+        demand = sum(t["c_ms"] / periods[t["name"]] for t in tasks if periods[t["name"]] <= period)
+        if demand + blocking[task["name"]] / period > 1.0 + 1e-12:
+            return False
+    return True
+
+
+def scaled_periods(tasks, base, scale, granularity):
+    """Escala os períodos da cadeia de controle, arredondando para cima em múltiplos de granularity ms."""
+    periods = dict(base)
+    for task in tasks:
+        if task["group"] == CONTROL_GROUP:
+            steps = math.ceil(base[task["name"]] * scale / granularity - 1e-9)
+            periods[task["name"]] = max(1, steps) * granularity
+    return periods
+
+
+def shortest_scale(tasks, base, holds, feasible, granularity):
+    """Menor fator s em (0, 1] tal que os períodos escalados passam em feasible (busca binária)."""
+    if not feasible(tasks, base, holds):
+        return None
+    low, high = 0.0, 1.0
+    for _ in range(50):
+        middle = (low + high) / 2
+        if feasible(tasks, scaled_periods(tasks, base, middle, granularity), holds):
+            high = middle
+        else:
+            low = middle
+    return high
+
+
+def chain_latency(periods, responses):
+    """Pior latência da cadeia com amostragem periódica: soma de T + R por estágio (o pior estágio paralelo)."""
+    total = 0.0
+    for stage in CONTROL_CHAIN:
+        names = [name for name in stage if name in periods]
+        if not names or any(responses[name] is None for name in names):
+            return None
+        total += max(periods[name] + responses[name] for name in names)
+    return total
+
+
+# --- Relatório ---
+
+def format_ms(value, unit=""):
+    return "não cabe" if value is None else f"{value:.4f}{unit}"
+
+
+def report_periods(lines, title, tasks, periods, holds):
+    blocking = blocking_terms(tasks, periods, holds)
+    responses = response_times(tasks, periods, blocking)
+    lines.append(title)
+    lines.append(f"  {'Tarefa':<14} {'T (ms)':>7} {'C (ms)':>9} {'B (ms)':>9} {'R RMS (ms)':>11} {'R/T':>7}")
+    for task in sorted(tasks, key=lambda t: periods[t["name"]]):
+        name = task["name"]
+        r = responses[name]
+        ratio = "-" if r is None else f"{r / periods[name]:.3f}"
+        lines.append(f"  {name:<14} {periods[name]:>7} {task['c_ms']:>9.4f} {blocking[name]:>9.4f} "
+                     f"{format_ms(r):>11} {ratio:>7}")
+    n = len(tasks)
+    u = utilization(tasks, periods)
+    lines.append(f"  U = {u:.4f} | Liu & Layland n(2^(1/n) - 1) = {liu_layland_bound(n):.4f} "
+                 f"({'garante' if u <= liu_layland_bound(n) else 'não garante'} RMS) | "
+                 f"EDF U <= 1: {'sim' if u <= 1 else 'não'}")
+    lines.append(f"  RMS (tempo de resposta com bloqueio): {'escalonável' if rms_feasible(tasks, periods, holds) else 'NÃO escalonável'}"
+                 f" | EDF com bloqueio: {'escalonável' if edf_feasible(tasks, periods, holds) else 'NÃO escalonável'}")
+    latency = chain_latency(periods, responses)
+    lines.append(f"  Latência da cadeia de controle no pior caso (soma de T + R, RMS): {format_ms(latency, ' ms')}")
+    # No EDF com deadline = período, R <= T para toda tarefa escalonável
+    latency = chain_latency(periods, dict(periods)) if edf_feasible(tasks, periods, holds) else None
+    lines.append(f"  Latência da cadeia de controle no pior caso (soma de 2T, EDF): {format_ms(latency, ' ms')}")
+    lines.append("")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Análise de tempo de resposta RMS/EDF com os tempos medidos")
+    parser.add_argument("--margem", type=float, help="fator sobre o WCET medido (padrão: WCET_MARGIN de main.c)")
+    parser.add_argument("--granularidade", type=int, default=1,
+                        help="períodos sugeridos em múltiplos deste valor em ms (padrão: 1)")
+    parser.add_argument("--stats", default=os.path.join(OUTPUT_DIR, "task_stats.txt"))
+    parser.add_argument("--locks", default=os.path.join(OUTPUT_DIR, "lock_stats.txt"))
+    args = parser.parse_args()
+    if args.granularidade < 1:
+        sys.exit("--granularidade deve ser pelo menos 1 ms")
+
+    defines = read_defines(MAIN_SOURCE, TASKS_HEADER)
+    margin = args.margem if args.margem is not None else defines.get("WCET_MARGIN", 1.0)
+    min_budget = defines.get("MIN_BUDGET_MS", 0.0)
+    default_wcet = defines.get("DEFAULT_WCET_MS", 1.0)
+
+    tasks = read_task_table(defines)
+    if not tasks:
+        sys.exit(f"Nenhuma tarefa encontrada em {MAIN_SOURCE}")
+    wcet = read_measured_wcet(args.stats)
+    holds = read_lock_holds(args.locks)
+    for task in tasks:
+        task["wcet_ms"] = wcet.get(task["name"], default_wcet)
+        task["c_ms"] = max(task["wcet_ms"] * margin, min_budget)
+    base = {t["name"]: t["period_ms"] for t in tasks}
+
+    lines = ["Análise de Tempo de Resposta", "=" * 28, ""]
+    lines.append(f"WCET: {'medido em ' + args.stats if wcet else 'estimativa padrão (sem medição)'} | "
+                 f"C = max(WCET x {margin:g}, {min_budget:g} ms)")
+    missing = [t["name"] for t in tasks if t["name"] not in wcet]
+    if wcet and missing:
+        lines.append(f"Sem medição (WCET padrão de {default_wcet:g} ms): {', '.join(missing)}")
+    lines.append(f"Bloqueio: {'posse máxima medida em ' + args.locks if holds else 'sem ' + args.locks + ' (B = 0)'}")
+    lines.append("")
+
+    report_periods(lines, "Períodos atuais", tasks, base, holds)
+
+    for label, feasible in (("RMS", rms_feasible), ("EDF", edf_feasible)):
+        scale = shortest_scale(tasks, base, holds, feasible, args.granularidade)
+        if scale is None:
+            lines.append(f"{label}: o conjunto atual não é escalonável; aumente os períodos ou reduza C.")
+            lines.append("")
+            continue
+        periods = scaled_periods(tasks, base, scale, args.granularidade)
+        control = [t["name"] for t in tasks if t["group"] == CONTROL_GROUP]
+        # Depois do arredondamento, a escala efetiva é a do período menos reduzido
+        effective = max(periods[name] / base[name] for name in control)
+        chain = ", ".join(f"{name}={periods[name]}" for name in control)
+        lines.append(f"{label}: menor escala da cadeia de controle = {effective:.4f} -> {chain} ms")
+        report_periods(lines, f"Períodos sugeridos ({label})", tasks, periods, holds)
+
+    report = "\n".join(lines) + "\n"
+    print(report, end="")
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    path = os.path.join(OUTPUT_DIR, "response_time_analysis.txt")
+    with open(path, "w") as f:
+        f.write(report)
+    print(f"Relatório salvo em {path}")
+
+
+if __name__ == "__main__":
+    main()
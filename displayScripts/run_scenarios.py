@@ -0,0 +1,379 @@
+"""
+Executa o ./bin/app_final em uma matriz de cenários (política de escalonamento x
+carga x afinidade x modo de registro), guarda as saídas de cada execução em
+output/cenarios/<cenário>/ e gera um relatório comparativo com percentis de
+jitter por tarefa, perdas de deadline e erro de rastreamento. Cada cenário é
+aprovado ou reprovado por limites por política; o código de saída é 1 se algum
+cenário for reprovado, de modo que o script pode barrar mudanças (make full_test).
+Cada execução roda em um diretório temporário, sem tocar nos output/*.txt do
+usuário (task_stats.txt e lock_stats.txt alimentam a admissão e o make rta).
+Combinações em que o kernel recusa a política pedida (deadline com afinidade
+restrita) são executadas mesmo assim e avaliadas pela política efetiva; o
+recuo esperado aparece no relatório, sem reprovar.
+
+Uso:
+    python3 displayScripts/run_scenarios.py [--policies other,fifo,deadline]
+        [--load off,on] [--affinity livre,fixa] [--logging terminal,telemetria]
+        [--load-threads N] [--limits limites.json]
+
+Se o cyclictest estiver instalado, ele roda em paralelo a cada cenário e a
+latência máxima medida entra no relatório.
+"""
+import argparse
+import itertools
+import json
+import math
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+
+# Caminho absoluto da pasta onde este script está
+BASE_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.abspath(os.path.join(BASE_DIR, ".."))
+OUTPUT_DIR = os.path.join(REPO_DIR, "output")
+SCENARIO_DIR = os.path.join(OUTPUT_DIR, "cenarios")
+APP = os.path.join(REPO_DIR, "bin", "app_final")
+
+POLICIES = ["other", "fifo", "deadline"]
+LOAD_MODES = ["off", "on"]
+AFFINITY_MODES = ["livre", "fixa"]
+LOGGING_MODES = ["terminal", "telemetria"]
+
+"""
+Limites de aprovação por política. miss_rate é a fração máxima de ativações
+com perda de deadline; jitter_p99_ms limita o percentil 99 de |T(k) - T| de
+cada tarefa; tracking_rms_m limita o erro RMS entre a saída do robô e a
+referência. "carga" sobrescreve os limites quando há threads de carga.
+Um arquivo JSON com a mesma estrutura (--limits) substitui os valores; em
+máquinas virtuais use displayScripts/limites_vm.json.
+"""
+DEFAULT_LIMITS = {
+    "other": {"miss_rate": 0.01, "jitter_p99_ms": 2.0, "tracking_rms_m": 0.5,
+              "carga": {"miss_rate": 0.05, "jitter_p99_ms": 10.0}},
+    "fifo": {"miss_rate": 0.0, "jitter_p99_ms": 1.0, "tracking_rms_m": 0.5},
+    "deadline": {"miss_rate": 0.0, "jitter_p99_ms": 1.0, "tracking_rms_m": 0.5},
+}
+
+TIMEOUT_S = 120  # a simulação dura 20 s; folga para admissão e relatórios
+
+
+def parse_list(value, allowed, option):
+    items = [v.strip() for v in value.split(",") if v.strip()]
+    for item in items:
+        if item not in allowed:
+            sys.exit(f"Valor inválido para {option}: {item} (opções: {', '.join(allowed)})")
+    return items
+
+
+def load_limits(path):
+    limits = json.loads(json.dumps(DEFAULT_LIMITS))
+    if path:
+        with open(path) as f:
+            for policy, values in json.load(f).items():
+                limits.setdefault(policy, {}).update(values)
+    return limits
+
+
+def limits_for(limits, policy, load):
+    base = {k: v for k, v in limits[policy].items() if k != "carga"}
+    if load:
+        base.update(limits[policy].get("carga", {}))
+    return base
+
+
+def affinity_spec():
+    """Cadeia de controle na última CPU, interface na CPU 0 (com uma CPU, tudo na 0)."""
+    last = (os.cpu_count() or 1) - 1
+    return f"controle={last};interface=0"
+
+
+def expected_fallback(policy, affinity):
+    """Política para a qual o conjunto recua na combinação, ou None.
+
+    SCHED_DEADLINE exige que a afinidade da thread cubra todo o domínio de
+    escalonamento; com a cadeia de controle fixada em uma CPU de várias, o
+    kernel recusa (EPERM) e as tarefas recuam para fifo.
+    """
+    if policy == "deadline" and affinity == "fixa" and (os.cpu_count() or 1) > 1:
+        return "fifo"
+    return None
+
+
+def effective_policy(summary):
+    """Política em que o cenário é avaliado: a pedida ou o recuo esperado."""
+    ran = {task["policy"] for task in summary["tasks"]}
+    if ran and ran == {summary["expected_fallback"]}:
+        return summary["expected_fallback"]
+    return summary["policy"]
+
+
+def percentile(sorted_values, q):
+    """Percentil pelo posto mais próximo."""
+    if not sorted_values:
+        return float("nan")
+    rank = max(1, math.ceil(q / 100.0 * len(sorted_values)))
+    return sorted_values[rank - 1]
+
+
+# --- Leitura das Saídas ---
+
+def read_task_stats(path):
+    """output/task_stats.txt: uma linha por tarefa (TSV com cabeçalho)."""
+    tasks = []
+    with open(path) as f:
+        header = f.readline().split()
+        for line in f:
+            fields = line.split()
+            if len(fields) != len(header):
+                continue
+            row = dict(zip(header, fields))
+            tasks.append({
+                "name": row["tarefa"],
+                "period_ms": float(row["periodo_ms"]),
+                "policy": row["politica"],
+                "activations": int(row["ativacoes"]),
+                "misses": int(row["perdas"]),
+                "c_max_ms": float(row["c_max_ms"]),
+            })
+    return tasks
+
+
+def read_jitter(output_dir, name, period_ms):
+    """|T(k) - T| em ms a partir de output/<tarefa>_timing.txt, sem a primeira amostra."""
+    path = os.path.join(output_dir, f"{name}_timing.txt")
+    values = []
+    try:
+        with open(path) as f:
+            f.readline()  # T(k)
+            for line in f:
+                try:
+                    t = float(line)
+                except ValueError:
+                    continue
+                if t > 1:
+                    values.append(abs(t - period_ms))
+    except FileNotFoundError:
+        pass
+    return sorted(values[1:])
+
+
+def read_tracking_error(output_dir):
+    """Erro entre a saída (x, y) e a referência (xref, yref) em cada registro do logger."""
+    path = os.path.join(output_dir, "simulation_output.txt")
+    errors = []
+    try:
+        with open(path) as f:
+            header = f.readline().split()
+            col = {name: i for i, name in enumerate(header)}
+            for line in f:
+                fields = line.split()
+                if len(fields) != len(header):
+                    continue
+                dx = float(fields[col["x"]]) - float(fields[col["xref"]])
+                dy = float(fields[col["y"]]) - float(fields[col["yref"]])
+                errors.append(math.hypot(dx, dy))
+    except FileNotFoundError:
+        pass
+    if not errors:
+        return float("nan"), float("nan")
+    return math.sqrt(sum(e * e for e in errors) / len(errors)), max(errors)
+
+
+def parse_cyclictest(output):
+    """Maior 'Max:' entre as threads do resumo do cyclictest (us)."""
+    worst = None
+    for token_line in output.splitlines():
+        if "Max:" in token_line:
+            try:
+                value = int(token_line.split("Max:")[1].split()[0])
+            except (IndexError, ValueError):
+                continue
+            worst = value if worst is None else max(worst, value)
+    return worst
+
+
+# --- Execução ---
+
+def scenario_name(policy, load, affinity, logging):
+    return f"{policy}-{'carga' if load else 'sem_carga'}-{affinity}-{logging}"
+
+
+def run_scenario(policy, load, affinity, logging, load_threads):
+    name = scenario_name(policy, load, affinity, logging)
+    target = os.path.join(SCENARIO_DIR, name)
+    shutil.rmtree(target, ignore_errors=True)
+    os.makedirs(target)
+
+    summary = {"name": name, "policy": policy, "load": load, "affinity": affinity, "logging": logging,
+               "exit_code": None, "cyclictest_max_us": None,
+               "expected_fallback": expected_fallback(policy, affinity), "tasks": []}
+
+    command = [APP, "-p", policy]
+    if load:
+        command += ["-l", str(load_threads)]
+    if affinity == "fixa":
+        command += ["-a", affinity_spec()]
+    if logging == "telemetria":
+        command += ["-t"]
+
+    # O app grava em output/ relativo ao diretório de trabalho: rodando em um
+    # diretório temporário, o cenário parte do WCET padrão (sem task_stats.txt),
+    # só as saídas desta execução são lidas e as do usuário ficam intactas
+    work_dir = tempfile.mkdtemp(prefix="cenario_")
+    run_output = os.path.join(work_dir, "output")
+    os.makedirs(run_output)
+    stats_path = os.path.join(run_output, "task_stats.txt")
+
+    cyclictest = None
+    if shutil.which("cyclictest"):
+        cyclictest = subprocess.Popen(["cyclictest", "-q", "-m", "-p", "90", "-i", "1000", "-t", "1"],
+                                      stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+
+    print(f"--- {name}: {' '.join(command[1:])}", flush=True)
+    with open(os.path.join(target, "app_stdout.txt"), "w") as out:
+        try:
+            result = subprocess.run(command, cwd=work_dir, stdin=subprocess.DEVNULL, stdout=out,
+                                    stderr=subprocess.STDOUT, timeout=TIMEOUT_S)
+            summary["exit_code"] = result.returncode
+        except subprocess.TimeoutExpired:
+            pass
+
+    if cyclictest is not None:
+        cyclictest.send_signal(signal.SIGINT)  # o resumo é impresso ao receber SIGINT
+        output, _ = cyclictest.communicate(timeout=10)
+        summary["cyclictest_max_us"] = parse_cyclictest(output)
+        with open(os.path.join(target, "cyclictest.txt"), "w") as f:
+            f.write(output)
+
+    # Cópia das saídas da execução
+    for entry in os.listdir(run_output):
+        path = os.path.join(run_output, entry)
+        if os.path.isfile(path) and entry.endswith(".txt"):
+            shutil.copy(path, target)
+
+    if summary["exit_code"] == 0 and os.path.exists(stats_path):
+        read_results(summary, run_output)
+    shutil.rmtree(work_dir, ignore_errors=True)
+    return summary
+
+
+def read_results(summary, output_dir):
+    for task in read_task_stats(os.path.join(output_dir, "task_stats.txt")):
+        jitter = read_jitter(output_dir, task["name"], task["period_ms"])
+        task.update({
+            "jitter_p50_ms": percentile(jitter, 50),
+            "jitter_p95_ms": percentile(jitter, 95),
+            "jitter_p99_ms": percentile(jitter, 99),
+            "jitter_max_ms": jitter[-1] if jitter else float("nan"),
+        })
+        summary["tasks"].append(task)
+    summary["tracking_rms_m"], summary["tracking_max_m"] = read_tracking_error(output_dir)
+
+
+def evaluate(summary, limits):
+    """Lista de motivos de reprovação (vazia se o cenário passou)."""
+    if summary["exit_code"] != 0:
+        status = "tempo esgotado" if summary["exit_code"] is None else f"código {summary['exit_code']}"
+        return [f"execução falhou ({status})"]
+
+    policy = effective_policy(summary)
+    limit = limits_for(limits, policy, summary["load"])
+    reasons = []
+    for task in summary["tasks"]:
+        rate = task["misses"] / task["activations"] if task["activations"] else 1.0
+        if rate > limit["miss_rate"]:
+            reasons.append(f"{task['name']}: {task['misses']} perdas ({100 * rate:.1f}%)")
+        if not task["jitter_p99_ms"] <= limit["jitter_p99_ms"]:
+            reasons.append(f"{task['name']}: |J| p99 {task['jitter_p99_ms']:.3f} ms")
+        if task["policy"] != policy:
+            reasons.append(f"{task['name']}: rodou em {task['policy']}")
+    if not summary["tracking_rms_m"] <= limit["tracking_rms_m"]:
+        reasons.append(f"erro RMS de rastreamento {summary['tracking_rms_m']:.3f} m")
+    return reasons
+
+
+# --- Relatório ---
+
+def write_report(summaries, limits, path):
+    lines = ["Relatório Comparativo de Cenários", "=" * 33, ""]
+    lines.append(f"{'Cenário':<38} {'Perdas':>7} {'|J| p99 máx':>12} {'|J| máx':>9} "
+                 f"{'Erro RMS':>9} {'Erro máx':>9} {'cyclictest':>11}  Resultado")
+    failed = 0
+    for s in summaries:
+        reasons = evaluate(s, limits)
+        failed += bool(reasons)
+        tasks = s["tasks"]
+        misses = sum(t["misses"] for t in tasks)
+        p99 = max((t["jitter_p99_ms"] for t in tasks), default=float("nan"))
+        jmax = max((t["jitter_max_ms"] for t in tasks), default=float("nan"))
+        latency = f"{s['cyclictest_max_us']} us" if s["cyclictest_max_us"] is not None else "-"
+        lines.append(f"{s['name']:<38} {misses:>7} {p99:>12.3f} {jmax:>9.3f} "
+                     f"{s.get('tracking_rms_m', float('nan')):>9.3f} {s.get('tracking_max_m', float('nan')):>9.3f} "
+                     f"{latency:>11}  {'REPROVADO' if reasons else 'aprovado'}")
+
+    lines += ["", "Jitter por tarefa (|T(k) - T| em ms) e perdas de deadline", ""]
+    for s in summaries:
+        policy = effective_policy(s)
+        limit = limits_for(limits, policy, s["load"])
+        lines.append(f"[{s['name']}] limites: perdas <= {100 * limit['miss_rate']:.1f}%, "
+                     f"|J| p99 <= {limit['jitter_p99_ms']} ms, erro RMS <= {limit['tracking_rms_m']} m")
+        if policy != s["policy"]:
+            lines.append(f"  Recuo esperado para {policy} (SCHED_DEADLINE não aceita afinidade restrita "
+                         f"a parte das CPUs); avaliado com os limites de {policy}")
+        if s["tasks"]:
+            lines.append(f"  {'Tarefa':<14} {'T':>5} {'p50':>8} {'p95':>8} {'p99':>8} {'máx':>8} "
+                         f"{'Ativ.':>7} {'Perdas':>7} {'C máx':>8}")
+        for t in s["tasks"]:
+            lines.append(f"  {t['name']:<14} {t['period_ms']:>5.0f} {t['jitter_p50_ms']:>8.3f} "
+                         f"{t['jitter_p95_ms']:>8.3f} {t['jitter_p99_ms']:>8.3f} {t['jitter_max_ms']:>8.3f} "
+                         f"{t['activations']:>7} {t['misses']:>7} {t['c_max_ms']:>8.4f}")
+        for reason in evaluate(s, limits):
+            lines.append(f"  REPROVADO: {reason}")
+        lines.append("")
+
+    lines.append(f"{len(summaries) - failed} de {len(summaries)} cenários aprovados.")
+    if not shutil.which("cyclictest"):
+        lines.append("cyclictest não encontrado: latências externas não medidas.")
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("\n".join(lines))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Matriz de cenários GPOS x RTOS do app_final")
+    parser.add_argument("--policies", default=",".join(POLICIES))
+    parser.add_argument("--load", default=",".join(LOAD_MODES))
+    parser.add_argument("--affinity", default=",".join(AFFINITY_MODES))
+    parser.add_argument("--logging", default=",".join(LOGGING_MODES))
+    parser.add_argument("--load-threads", type=int, default=os.cpu_count() or 1,
+                        help="threads de carga nos cenários com carga (padrão: número de CPUs)")
+    parser.add_argument("--limits", help="arquivo JSON que sobrescreve os limites de aprovação")
+    args = parser.parse_args()
+
+    if not os.path.exists(APP):
+        sys.exit(f"{APP} não encontrado; compile com 'make' antes.")
+
+    policies = parse_list(args.policies, POLICIES, "--policies")
+    loads = [mode == "on" for mode in parse_list(args.load, LOAD_MODES, "--load")]
+    affinities = parse_list(args.affinity, AFFINITY_MODES, "--affinity")
+    loggings = parse_list(args.logging, LOGGING_MODES, "--logging")
+    limits = load_limits(args.limits)
+
+    os.makedirs(SCENARIO_DIR, exist_ok=True)
+    summaries = []
+    for policy, load, affinity, logging in itertools.product(policies, loads, affinities, loggings):
+        summaries.append(run_scenario(policy, load, affinity, logging, args.load_threads))
+
+    with open(os.path.join(SCENARIO_DIR, "resultados.json"), "w") as f:
+        json.dump(summaries, f, indent=2)
+    failed = write_report(summaries, limits, os.path.join(SCENARIO_DIR, "relatorio.txt"))
+    print(f"\nRelatório salvo em {os.path.join(SCENARIO_DIR, 'relatorio.txt')}")
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,48 @@
+#ifndef BATCHED_MATRIX_H
+#define BATCHED_MATRIX_H
+
+//------------------------------------------------------------------
+// Layout
+//------------------------------------------------------------------
+
+/*
+ * Lotes de problemas pequenos (2x2, 3x3 e 4x4) em layout intercalado: o
+ * elemento (r, c) do problema i fica em A[(r * K + c) * count + i] e o
+ * elemento r de um vetor em x[r * count + i]. Assim cada elemento forma um
+ * vetor contíguo ao longo do lote, e as lanes SIMD avançam entre problemas.
+ *
+ * Os kernels usam fórmulas fechadas e não desviam por problema: um problema
+ * singular (|det| < BATCH_SINGULAR_EPS, o mesmo limiar de inverseMatrix)
+ * produz zeros na saída e é contado no valor de retorno.
+ * Nenhuma função aloca memória; as saídas não podem sobrepor as entradas.
+ */
+
+#define BATCH_SINGULAR_EPS 1e-9
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// 2x2
+void batchDet2x2(int count, const double* A, double* det);
+int batchInverse2x2(int count, const double* A, double* Ainv);
+int batchSolve2x2(int count, const double* A, const double* b, double* x);
+void batchMultiply2x2(int count, const double* A, const double* B, double* C);
+void batchMatVec2x2(int count, const double* A, const double* x, double* y);
+
+// 3x3
+void batchDet3x3(int count, const double* A, double* det);
+int batchInverse3x3(int count, const double* A, double* Ainv);
+int batchSolve3x3(int count, const double* A, const double* b, double* x);
+void batchMultiply3x3(int count, const double* A, const double* B, double* C);
+void batchMatVec3x3(int count, const double* A, const double* x, double* y);
+
+// 4x4
+void batchDet4x4(int count, const double* A, double* det);
+int batchInverse4x4(int count, const double* A, double* Ainv);
+int batchSolve4x4(int count, const double* A, const double* b, double* x);
+void batchMultiply4x4(int count, const double* A, const double* B, double* C);
+void batchMatVec4x4(int count, const double* A, const double* x, double* y);
+
+#endif // BATCHED_MATRIX_H
@@ -0,0 +1,104 @@
+#ifndef CONTROL_TASKS_H
+#define CONTROL_TASKS_H
+
+#include <pthread.h>
+#include "matrixOperations.h"
+#include "trace.h"
+#include "profiledMutex.h"
+
+// --- Constantes da Simulação ---
+#define SIMULATION_TIME 20.0
+
+// --- Períodos das Threads (em milissegundos) ---
+#define ROBOT_SIM_PERIOD_MS 30
+#define LINEARIZATION_PERIOD_MS 40
+#define CONTROL_PERIOD_MS 50
+#define REF_MODEL_X_PERIOD_MS 50
+#define REF_MODEL_Y_PERIOD_MS 50
+#define REFERENCE_GEN_PERIOD_MS 120
+#define LOGGER_PERIOD_MS 100
+
+// --- Identificadores das Tarefas (posição na tabela do app_final e id nos traces) ---
+enum {
+    TASK_REF_GEN,
+    TASK_REF_MODEL_X,
+    TASK_REF_MODEL_Y,
+    TASK_CONTROL,
+    TASK_LINEARIZATION,
+    TASK_ROBOT_SIM,
+    TASK_LOGGER,
+};
+
+// --- Variáveis Compartilhadas e Mutexes (com herança de prioridade e perfil de uso) ---
+extern double current_time;
+extern ProfiledMutex time_mutex;
+
+extern Matrix* x_state;         // [xc, yc, theta]T
+extern ProfiledMutex x_state_mutex;
+
+extern Matrix* y_output;        // [y1, y2]T
+extern ProfiledMutex y_output_mutex;
+
+extern Matrix* v_input;         // [v1, v2]T
+extern ProfiledMutex v_input_mutex;
+
+extern Matrix* u_input;         // [v, w]T
+extern ProfiledMutex u_input_mutex;
+
+extern Matrix* ym_output;       // [ymx, ymy]T
+extern ProfiledMutex ym_output_mutex;
+
+extern Matrix* ym_dot_output;   // [ymx_dot, ymy_dot]T
+extern ProfiledMutex ym_dot_output_mutex;
+
+extern Matrix* ref_input;       // [xref, yref]T
+extern ProfiledMutex ref_input_mutex;
+
+extern double alpha1;
+extern double alpha2;
+extern ProfiledMutex alpha_mutex;
+
+// Todas as travas acima, para os relatórios de contenção
+#define NUM_SHARED_LOCKS 9
+extern ProfiledMutex* const shared_locks[NUM_SHARED_LOCKS];
+
+/*
+ * Travas dos sinais compartilhados. No executivo cíclico todas as tarefas rodam
+ * em uma única thread e shared_locking é desligado antes da execução: os corpos
+ * das tarefas são os mesmos, apenas sem travas.
+ */
+extern int shared_locking;
+
+static inline void lock_shared(ProfiledMutex* mutex) {
+    if (shared_locking) profiledLock(mutex);
+}
+
+static inline void unlock_shared(ProfiledMutex* mutex) {
+    if (shared_locking) profiledUnlock(mutex);
+}
+
+// Gravador de sinais (NULL quando a gravação está desligada)
+extern TraceRecorder* recorder;
+
+// --- Gerenciamento do Estado Compartilhado ---
+// Cria as travas e as matrizes compartilhadas. Retorna 0, ou -1 se alguma trava falhar.
+int init_shared_state(void);
+void free_shared_state(void);
+
+// Estado interno dos modelos de referência (usado pelo replay)
+void set_ref_model_state(double ymx, double ymy);
+
+// Publica um sinal no gravador, se ele estiver ativo
+void record_signal(int signal, int task, const double* values, int count);
+// Grava um valor lido pela tarefa (chamar com a trava do sinal ainda adquirida)
+void record_input(int signal, int task, const double* values, int count);
+
+// --- Corpos das Tarefas (um período de cada) ---
+void reference_generation_step(void);
+void ref_model_x_step(void);
+void ref_model_y_step(void);
+void control_step(void);
+void linearization_step(void);
+void robot_simulation_step(void);
+
+#endif // CONTROL_TASKS_H
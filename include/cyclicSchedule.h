@@ -0,0 +1,41 @@
+#ifndef CYCLIC_SCHEDULE_H
+#define CYCLIC_SCHEDULE_H
+
+//------------------------------------------------------------------
+// Estrutura
+//------------------------------------------------------------------
+
+#define CYCLIC_MAX_TASKS 16
+#define CYCLIC_MAX_FRAMES 256
+
+/*
+ * Escalonamento estático de um executivo cíclico. O quadro menor é o MDC dos
+ * períodos e o quadro maior (hiperperíodo) é o MMC, de modo que toda liberação
+ * cai exatamente no início de um quadro. frame_tasks[f] lista, na ordem da
+ * tabela de tarefas, as tarefas liberadas no quadro f.
+ */
+typedef struct {
+    int minor_ms;                                          // duração de um quadro
+    int major_ms;                                          // hiperperíodo
+    int num_frames;                                        // major_ms / minor_ms
+    int num_tasks;
+    int frame_count[CYCLIC_MAX_FRAMES];                    // tarefas liberadas em cada quadro
+    int frame_tasks[CYCLIC_MAX_FRAMES][CYCLIC_MAX_TASKS];  // índices na tabela de tarefas
+} CyclicSchedule;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+/*
+ * Gera o escalonamento a partir dos períodos (em ms). Retorna 0 em caso de
+ * sucesso e -1 se houver período inválido, tarefas demais ou se o hiperperíodo
+ * exigir mais de CYCLIC_MAX_FRAMES quadros.
+ */
+int buildCyclicSchedule(const int* periods_ms, int num_tasks, CyclicSchedule* schedule);
+
+// Imprime a tabela de quadros (um quadro por linha, com os nomes das tarefas)
+void printCyclicSchedule(const CyclicSchedule* schedule, const char* const* names);
+
+#endif // CYCLIC_SCHEDULE_H
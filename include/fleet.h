@@ -0,0 +1,78 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+/*
+ * Estado de uma frota de robôs em estrutura-de-vetores (SoA): cada campo é um
+ * vetor contíguo de count elementos, de modo que cada estágio da cadeia de
+ * controle percorre a frota com acesso sequencial à memória.
+ */
+typedef struct {
+    int count;
+
+    // Robô: estado [xc, yc, theta] e saída [y1, y2]
+    double* xc;
+    double* yc;
+    double* theta;
+    double* y1;
+    double* y2;
+
+    // Modelo de referência e suas derivadas
+    double* ymx;
+    double* ymy;
+    double* ymx_dot;
+    double* ymy_dot;
+
+    // Controlador: ganhos, defasagem da referência de cada robô e entradas v e u
+    double* alpha1;
+    double* alpha2;
+    double* phase;
+    double* v1;
+    double* v2;
+    double* v;
+    double* w;
+
+    double* block;   // bloco único que contém todos os vetores acima
+} FleetState;
+
+// Configuração do pool de workers periódicos
+typedef struct {
+    int workers;        // número de threads (uma por núcleo)
+    int period_ms;      // período de cada worker
+    double duration_s;  // duração da medição
+    int pin;            // 1 fixa o worker i na CPU i (módulo o número de CPUs)
+} FleetConfig;
+
+// Resultado agregado de uma execução
+typedef struct {
+    int workers;               // workers efetivamente usados (no máximo um por robô)
+    long activations;          // ativações somadas de todos os workers
+    long misses;               // ativações que terminaram após a próxima liberação
+    double exec_mean_ms;       // tempo médio de processamento de um lote
+    double exec_max_ms;        // pior tempo de processamento de um lote
+    double latency_p50_us;     // atraso de liberação (jitter de ativação)
+    double latency_p99_us;
+    double latency_max_us;
+    double steps_per_s;        // vazão: passos de robô por segundo de CPU ocupada
+    double utilization;        // maior fração do período ocupada por um worker
+} FleetReport;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Gerenciamento de memória
+FleetState* createFleet(int count);
+void freeFleet(FleetState* fleet);
+
+// Executa um período completo da cadeia de controle para os robôs [begin, end)
+void fleetStep(FleetState* fleet, int begin, int end, double t, double dt);
+
+// Roda a frota no pool de workers e preenche o relatório. Retorna 0 em caso de sucesso.
+int runFleet(FleetState* fleet, const FleetConfig* config, FleetReport* report);
+
+#endif // FLEET_H
@@ -0,0 +1,75 @@
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "matrixOperations.h"
+
+//------------------------------------------------------------------
+// Constantes
+//------------------------------------------------------------------
+
+#define MATRIX_FILE_MAGIC 0x584d5452u   // "RTMX"
+#define MATRIX_FILE_VERSION 1u
+#define MATRIX_FILE_ALIGN 64            // alinhamento do início dos dados no arquivo
+
+typedef enum {
+    MATRIX_DTYPE_F64 = 1
+} MatrixDtype;
+
+// Opções de mapMatrixBinary
+#define MATRIX_IO_VERIFY 1   // confere a soma de verificação (lê todas as páginas)
+
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+/*
+ * Cabeçalho de 64 bytes no início do arquivo, na ordem de bytes da máquina.
+ * Os dados ficam em data_offset (múltiplo de MATRIX_FILE_ALIGN), linha a
+ * linha e sem preenchimento entre linhas (stride == cols).
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t dtype;          // MatrixDtype
+    uint32_t elem_size;      // bytes por elemento
+    uint64_t stride;         // elementos entre inícios de linha (sempre cols nesta versão)
+    uint64_t data_offset;    // bytes do início do arquivo até os dados
+    uint64_t data_bytes;
+    uint64_t checksum;       // FNV-1a sobre as palavras de 64 bits dos rows x cols elementos
+    uint8_t reserved[8];
+} MatrixFileHeader;
+
+/*
+ * Matriz mapeada do arquivo: matrix.data[i] aponta diretamente para a linha i
+ * do mapeamento (MAP_PRIVATE), sem cópia. Alterações ficam só no processo.
+ */
+typedef struct {
+    Matrix matrix;
+    void* map;
+    size_t map_size;
+} MappedMatrix;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Grava cabeçalho e dados em uma única chamada writev. Retorna 0 ou -1 (errno preservado).
+int saveMatrixBinary(const Matrix* matrix, const char* path);
+
+// Mapeia o arquivo e cria a visão sem cópia. Retorna NULL se o arquivo for inválido.
+MappedMatrix* mapMatrixBinary(const char* path, int flags);
+void unmapMatrixBinary(MappedMatrix* mapped);
+
+// Importa um CSV numérico (separadores: vírgula, ponto e vírgula, espaço ou tab).
+// Todas as linhas não vazias devem ter o mesmo número de colunas. Retorna NULL em caso de erro.
+Matrix* importMatrixCSV(const char* path);
+
+uint64_t matrixChecksum(const double* data, size_t count);
+
+#endif // MATRIX_IO_H
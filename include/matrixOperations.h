@@ -1,41 +1,63 @@
 #ifndef MATRIX_OPERATIONS
 #define MATRIX_OPERATIONS
 
+/*
+ * A biblioteca é gerada a partir de um único modelo para dois tipos de
+ * elemento: double (Matrix, funções sem sufixo: createMatrix, gemv, ...) e
+ * float (MatrixF, funções com sufixo F: createMatrixF, gemvF, ...). As
+ * declarações ficam em matrixDeclarations.inc e as implementações em
+ * src/matrixKernels.inc, incluídas uma vez por tipo.
+ */
+
+// Nome da função com o sufixo do tipo; removido ao fim das declarações
+#define MATRIX_CONCAT_(a, b) a##b
+#define MATRIX_CONCAT(a, b) MATRIX_CONCAT_(a, b)
+#define MATRIX_FN(name) MATRIX_CONCAT(name, MATRIX_SUFFIX)
+
 //------------------------------------------------------------------
-// Estrutura
+// Precisão Dupla (Matrix)
 //------------------------------------------------------------------
 
-typedef struct {
-    int rows;
-    int cols;
-    double** data;
-} Matrix;
-
+#define MATRIX_REAL double
+#define MATRIX_TYPE Matrix
+#define MATRIX_SUFFIX
+#include "matrixDeclarations.inc"
+#undef MATRIX_REAL
+#undef MATRIX_TYPE
+#undef MATRIX_SUFFIX
 
 //------------------------------------------------------------------
-// Declaração das Funções
+// Precisão Simples (MatrixF)
 //------------------------------------------------------------------
 
-// Funções de Gerenciamento de Memória
-Matrix* createMatrix(int rows, int cols);
-void freeMatrix(Matrix* matrix);
-
-// Funções de Entrada e Saída (I/O)
-void scanMatrix(Matrix* matrix);
-void displayMatrix(Matrix* matrix);
-
-// Funções de Operações Matemáticas
-Matrix* addMatrix(Matrix* a, Matrix* b);
-Matrix* subMatrix(Matrix* a, Matrix* b);
-Matrix* multiplyMatrix(Matrix* a, Matrix* b);
-Matrix* scalarMultiply(Matrix* matrix, double scalar);
-Matrix* transposeMatrix(Matrix* matrix);
-Matrix* inverseMatrix(Matrix* matrix);
+#define MATRIX_REAL float
+#define MATRIX_TYPE MatrixF
+#define MATRIX_SUFFIX F
+#include "matrixDeclarations.inc"
+#undef MATRIX_REAL
+#undef MATRIX_TYPE
+#undef MATRIX_SUFFIX
 
-double determinant(Matrix* matrix);
+#undef MATRIX_FN
+#undef MATRIX_CONCAT
+#undef MATRIX_CONCAT_
 
+//------------------------------------------------------------------
+// Precisão Mista
+//------------------------------------------------------------------
 
-// Funções internas
-Matrix* getCofactor(Matrix* matrix, int p, int q);
-
-#endif // MATRIX_H
\ No newline at end of file
+// Copiam os elementos entre precisões (mesmo formato). Retornam 0 ou -1.
+int convertMatrixToFloat(const Matrix* src, MatrixF* dst);
+int convertMatrixToDouble(const MatrixF* src, Matrix* dst);
+
+/*
+ * Resolve A x = b com a fatoração LU em float e refinamento iterativo em
+ * double: r = b - A x (double), LU_f d = r (float), x += d, até que
+ * ||d||inf <= tolerance * ||x||inf. Converge para precisão dupla quando
+ * cond(A) é bem menor que 1/eps_float (~1e7). Retorna o número de
+ * refinamentos, ou -1 se A for singular em float ou não convergir em
+ * max_iterations (nesse caso use luFactor/luSolve em double).
+ */
+int mixedPrecisionSolve(const Matrix* A, const Matrix* b, Matrix* x, int max_iterations, double tolerance);
+
+#endif // MATRIX_H
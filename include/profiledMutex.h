@@ -0,0 +1,64 @@
+#ifndef PROFILED_MUTEX_H
+#define PROFILED_MUTEX_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+#define LOCK_HIST_BUCKETS 32   // balde b cobre [2^b, 2^(b+1)) ns
+#define LOCK_MAX_TASKS 8       // tarefas com estatística própria (ids 0..LOCK_MAX_TASKS-1)
+
+// Uso de uma trava por uma tarefa
+typedef struct {
+    long acquisitions;
+    long contended;            // aquisições que encontraram a trava ocupada
+    uint64_t sum_wait_ns;
+    uint64_t max_wait_ns;
+    uint64_t max_hold_ns;
+} LockTaskStats;
+
+/*
+ * Mutex com herança de prioridade (PTHREAD_PRIO_INHERIT) e perfil de uso.
+ * Todas as estatísticas são atualizadas por quem detém a trava, logo não
+ * precisam de operações atômicas: a espera é contabilizada logo após adquirir
+ * e a posse logo antes de liberar. A tarefa chamadora é identificada por um id
+ * por thread (profiledMutexSetTask).
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    const char* name;
+
+    long acquisitions;
+    long contended;
+    uint64_t max_wait_ns;
+    uint64_t max_hold_ns;
+    uint64_t wait_hist[LOCK_HIST_BUCKETS];   // somente aquisições com contenção
+    uint64_t hold_hist[LOCK_HIST_BUCKETS];
+    LockTaskStats tasks[LOCK_MAX_TASKS];
+
+    uint64_t acquired_ns;   // instante da aquisição corrente
+    int holder;             // tarefa que detém a trava (-1 = sem id)
+} ProfiledMutex;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Inicializa com PTHREAD_PRIO_INHERIT e zera o perfil. Retorna 0 ou o código de erro do pthread.
+int profiledMutexInit(ProfiledMutex* m, const char* name);
+void profiledMutexDestroy(ProfiledMutex* m);
+
+void profiledLock(ProfiledMutex* m);
+void profiledUnlock(ProfiledMutex* m);
+
+// Define o id de tarefa da thread chamadora (-1 para não atribuir a nenhuma tarefa)
+void profiledMutexSetTask(int task);
+
+// Limite superior (ns) do balde que contém o quantil q (0..1) do histograma; 0 se vazio
+uint64_t lockHistogramQuantile(const uint64_t* hist, double q);
+
+#endif // PROFILED_MUTEX_H
@@ -0,0 +1,66 @@
+#ifndef ROBOT_MODEL_H
+#define ROBOT_MODEL_H
+
+#include <math.h>
+
+//------------------------------------------------------------------
+// Constantes do Modelo
+//------------------------------------------------------------------
+
+#define ROBOT_DIAMETER 0.6
+#define R_ROBOT (ROBOT_DIAMETER / 2.0)
+#define PI 3.14159265358979323846
+
+
+//------------------------------------------------------------------
+// Equações de Cada Estágio
+//------------------------------------------------------------------
+
+/*
+ * Equações escalares da cadeia de controle, sem estado global. São usadas
+ * pelas tarefas do app_final e pela simulação de frota; ficam no cabeçalho
+ * (static inline) para que os laços da frota possam ser otimizados por inteiro.
+ */
+
+// Referência: ref(t) = [xref, yref]T
+static inline void referenceAt(double t, double* xref, double* yref) {
+    *xref = (5.0 / PI) * cos(0.2 * PI * t);
+    *yref = (t < 10.0) ? (5.0 / PI) * sin(0.2 * PI * t) : -(5.0 / PI) * sin(0.2 * PI * t);
+}
+
+// Modelo de referência de 1a ordem (Euler): atualiza ym e retorna ym_dot
+static inline double refModelStep(double* ym, double ref, double alpha, double dt) {
+    double ym_dot = alpha * (ref - *ym);
+    *ym += ym_dot * dt;
+    return ym_dot;
+}
+
+// Lei de controle: v = ym_dot + alpha * (ym - y)
+static inline double controlLaw(double ym_dot, double ym, double y, double alpha) {
+    return ym_dot + alpha * (ym - y);
+}
+
+// Linearização por realimentação: u = L(theta)^-1 * v, em forma fechada.
+// L = [cos -R sin; sin R cos] tem det(L) = R, logo L^-1 = [cos sin; -sin/R cos/R]
+static inline void linearizeInput(double theta, double v1, double v2, double* v, double* w) {
+    double c = cos(theta);
+    double s = sin(theta);
+    *v = c * v1 + s * v2;
+    *w = (-s * v1 + c * v2) / R_ROBOT;
+}
+
+// Integra o modelo cinemático do robô (uniciclo) por dt
+static inline void unicycleStep(double* xc, double* yc, double* theta, double v, double w, double dt) {
+    double th = *theta;
+    *xc += dt * cos(th) * v;
+    *yc += dt * sin(th) * v;
+    *theta = th + dt * w;
+}
+
+// Saída do robô: ponto à frente do eixo, y = [xc + R cos(theta), yc + R sin(theta)]T
+static inline void robotOutput(double xc, double yc, double theta, double* y1, double* y2) {
+    *y1 = xc + R_ROBOT * cos(theta);
+    *y2 = yc + R_ROBOT * sin(theta);
+}
+
+#endif // ROBOT_MODEL_H
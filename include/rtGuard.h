@@ -0,0 +1,56 @@
+#ifndef RT_GUARD_H
+#define RT_GUARD_H
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+#define RT_GUARD_MAX_TASKS 16
+#define RT_GUARD_ENV "RT_GUARD"   // count (padrão), trap ou off
+
+typedef enum {
+    RT_GUARD_OFF,
+    RT_GUARD_COUNT,   // conta as violações e segue
+    RT_GUARD_TRAP     // aborta na primeira alocação dentro da fase de tempo real
+} RtGuardMode;
+
+/*
+ * Violações de uma tarefa durante a fase de tempo real (o laço periódico).
+ * Alocações são contadas pelo alocador interposto (--wrap=malloc,free,calloc,
+ * realloc no link da aplicação); faltas de página e trocas de contexto são
+ * diferenças de getrusage(RUSAGE_THREAD) em torno de cada ativação, logo não
+ * incluem o sono entre ativações. Cada entrada é escrita só pela thread que
+ * executa a tarefa.
+ */
+typedef struct {
+    const char* name;
+    long activations;
+    long allocations;         // malloc, calloc e realloc
+    long frees;
+    long minor_faults;
+    long major_faults;
+    long voluntary_switches;  // bloqueios dentro da ativação (travas, E/S)
+    long involuntary_switches;
+    long faulting_activations;
+} RtGuardTaskStats;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Lê o modo da variável de ambiente RT_GUARD e registra os nomes das tarefas
+RtGuardMode rtGuardInit(const char* const* names, int num_tasks);
+const char* rtGuardModeName(RtGuardMode mode);
+
+// Marca o início e o fim da fase de tempo real da thread chamadora
+void rtGuardEnter(int task);
+void rtGuardLeave(void);
+
+// Delimitam uma ativação da tarefa (amostragem de getrusage)
+void rtGuardStepBegin(int task);
+void rtGuardStepEnd(void);
+
+const RtGuardTaskStats* rtGuardStats(int task);
+
+#endif // RT_GUARD_H
@@ -0,0 +1,65 @@
+#ifndef RT_POLICY_H
+#define RT_POLICY_H
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+/*
+ * Política de escalonamento das tarefas periódicas:
+ *  - POLICY_OTHER: SCHED_OTHER (CFS), sem garantia temporal;
+ *  - POLICY_FIFO: SCHED_FIFO com prioridades fixas atribuídas por RMS;
+ *  - POLICY_DEADLINE: SCHED_DEADLINE (EDF + servidor de banda constante), com
+ *    runtime/deadline/period reservados no kernel para cada tarefa.
+ */
+typedef enum {
+    POLICY_OTHER,
+    POLICY_FIFO,
+    POLICY_DEADLINE,
+} SchedPolicy;
+
+// Resultado do teste de admissão por utilização
+typedef struct {
+    double utilization;   // soma de C_i / T_i
+    double bound;         // limite da política (RMS: n(2^(1/n) - 1), EDF: 1)
+    int admitted;         // 1 se utilization <= bound
+} AdmissionResult;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// "other", "fifo" ou "deadline" -> SchedPolicy. Retorna 0 em caso de sucesso.
+int parsePolicy(const char* name, SchedPolicy* policy);
+
+const char* policyName(SchedPolicy policy);
+
+// Limite de utilização de Liu & Layland para n tarefas: n(2^(1/n) - 1)
+double rmsUtilizationBound(int n);
+
+/*
+ * Teste de admissão: FIFO usa o limite RMS (suficiente), DEADLINE usa U <= 1
+ * (necessário e suficiente para EDF com deadlines implícitos em um núcleo).
+ * POLICY_OTHER não oferece garantia e é sempre admitida (bound = 0).
+ */
+void admissionTest(SchedPolicy policy, const double* wcet_ms, const int* period_ms, int n, AdmissionResult* result);
+
+/*
+ * Aplica a política à thread chamadora. priority é usada em FIFO; runtime_ms
+ * e period_ms em DEADLINE (deadline = período). Retorna 0 ou o errno da falha
+ * (ex.: EPERM sem privilégio, EBUSY se o kernel recusar a banda).
+ */
+int applySchedPolicy(SchedPolicy policy, int priority, double runtime_ms, int period_ms);
+
+/*
+ * Aplica a política à thread chamadora e, se o kernel recusar (falta de
+ * privilégio, banda insuficiente, afinidade restrita em SCHED_DEADLINE), recua
+ * deadline -> fifo -> other, avisando em stderr com o nome da tarefa. other é
+ * sempre aplicada de fato, o que também rebaixa uma thread já em fifo ou
+ * deadline. Retorna a política efetiva.
+ */
+SchedPolicy applySchedPolicyWithFallback(const char* name, SchedPolicy policy, int priority, double runtime_ms,
+                                         int period_ms);
+
+#endif // RT_POLICY_H
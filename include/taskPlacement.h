@@ -0,0 +1,56 @@
+#ifndef TASK_PLACEMENT_H
+#define TASK_PLACEMENT_H
+
+#include <pthread.h>
+#include <sched.h>
+
+//------------------------------------------------------------------
+// Estrutura
+//------------------------------------------------------------------
+
+/*
+ * Afinidade de uma tarefa periódica e o contador de migrações observadas.
+ * Se pinned == 0 a tarefa roda com a afinidade herdada (kernel migra livremente).
+ */
+typedef struct {
+    cpu_set_t cpus;      // conjunto de CPUs permitido à tarefa
+    int pinned;          // 1 se a afinidade foi configurada explicitamente
+    int last_cpu;        // CPU observada na última ativação (-1 = nenhuma ainda)
+    long migrations;     // trocas de CPU entre ativações consecutivas
+    long samples;        // ativações amostradas
+} TaskPlacement;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Converte uma lista de CPUs ("2", "0-1", "0,2-3") em um cpu_set_t. Retorna 0 em caso de sucesso.
+int parseCpuList(const char* list, cpu_set_t* set);
+
+/*
+ * Resolve a afinidade de uma tarefa a partir de uma especificação no formato
+ * "chave=cpus;chave=cpus", em que a chave é o nome da tarefa, o nome do grupo
+ * ou "all". A entrada mais específica vence (tarefa > grupo > all).
+ * keys é a lista, terminada em NULL, de todas as chaves válidas além de "all";
+ * uma chave fora dela (ex.: nome de tarefa digitado errado) torna a
+ * especificação inválida.
+ * Retorna 0 em caso de sucesso (placement->pinned indica se houve casamento)
+ * e -1 se a especificação for inválida.
+ */
+int resolvePlacement(const char* spec, const char* task_name, const char* group, const char* const* keys,
+                     TaskPlacement* placement);
+
+// Aplica a afinidade aos atributos de criação da thread (nada é feito se a tarefa não for fixada).
+int applyPlacementAttr(pthread_attr_t* attr, const TaskPlacement* placement);
+
+// Confere se a afinidade efetiva da thread é a configurada. Retorna 0 se conferir.
+int verifyPlacement(pthread_t thread, const TaskPlacement* placement);
+
+// Registra a CPU atual da thread chamadora e conta uma migração se ela mudou.
+void samplePlacement(TaskPlacement* placement);
+
+// Formata o conjunto de CPUs como lista ("0-1,3") em buffer.
+void formatCpuList(const cpu_set_t* set, char* buffer, int size);
+
+#endif // TASK_PLACEMENT_H
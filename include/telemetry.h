@@ -0,0 +1,123 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdatomic.h>
+
+//------------------------------------------------------------------
+// Constantes
+//------------------------------------------------------------------
+
+#define TELEMETRY_SHM_NAME "/rtp_telemetry"
+#define TELEMETRY_MAGIC 0x52545054u      // "RTPT"
+#define TELEMETRY_VERSION 1u
+#define TELEMETRY_MAX_TASKS 8
+#define TELEMETRY_NAME_LEN 16
+#define TELEMETRY_CMD_CAPACITY 64        // potência de 2
+
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+// Estatísticas de temporização de uma tarefa periódica (todas em ms)
+typedef struct {
+    char name[TELEMETRY_NAME_LEN];
+    int period_ms;
+    long activations;
+    long misses;               // ativações que terminaram após liberação + período
+    long period_samples;       // número de T(k) medidos
+    double last_period_ms;     // último T(k) medido
+    double min_period_ms;
+    double max_period_ms;
+    double sum_period_ms;
+    double max_jitter_ms;      // maior |T(k) - período nominal|
+    double last_exec_ms;       // tempo de execução do corpo da tarefa
+    double max_exec_ms;
+    double sum_exec_ms;
+    double max_latency_ms;     // maior atraso entre a liberação e o início da execução
+} TaskTimingStats;
+
+/*
+ * Estatísticas de uma tarefa com o seu próprio seqlock: só a thread da tarefa
+ * escreve (telemetryRecordActivation) e as demais leem uma cópia consistente
+ * (telemetryReadStats), sem misturar campos de ativações diferentes.
+ */
+typedef struct {
+    atomic_uint sequence;
+    TaskTimingStats stats;
+} TaskStatsCell;
+
+// Fotografia do controlador publicada a cada atualização
+typedef struct {
+    double t;
+    double x_state[3];   // [xc, yc, theta]
+    double y[2];
+    double ref[2];
+    double ym[2];
+    double u[2];
+    double alpha1;
+    double alpha2;
+    int running;         // 0 quando o controlador encerrou
+    int num_tasks;
+    TaskTimingStats tasks[TELEMETRY_MAX_TASKS];
+} TelemetrySnapshot;
+
+// Comandos enviados pelo monitor ao controlador
+typedef enum {
+    TELEMETRY_CMD_SET_ALPHA1,
+    TELEMETRY_CMD_SET_ALPHA2,
+    TELEMETRY_CMD_ADD_ALPHA1,
+    TELEMETRY_CMD_ADD_ALPHA2,
+} TelemetryCommandType;
+
+typedef struct {
+    int type;      // TelemetryCommandType
+    double value;
+} TelemetryCommand;
+
+/*
+ * Segmento de memória compartilhada. A fotografia é protegida por um seqlock
+ * (sequence ímpar = escrita em andamento), de modo que o escritor nunca
+ * bloqueia; o monitor relê enquanto a sequência mudar. Os comandos seguem em
+ * um anel produtor/consumidor único: head é escrito pelo monitor e tail pelo
+ * controlador.
+ */
+typedef struct {
+    unsigned int magic;
+    unsigned int version;
+    atomic_uint sequence;
+    TelemetrySnapshot snapshot;
+    atomic_uint cmd_head;
+    atomic_uint cmd_tail;
+    TelemetryCommand commands[TELEMETRY_CMD_CAPACITY];
+} TelemetrySegment;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Lado do controlador: cria (ou recria) o segmento e o remove ao final
+TelemetrySegment* telemetryCreate(void);
+void telemetryDestroy(TelemetrySegment* segment);
+
+// Lado do monitor: anexa a um segmento existente
+TelemetrySegment* telemetryAttach(void);
+void telemetryDetach(TelemetrySegment* segment);
+
+// Seqlock: escrita sem bloqueio e leitura consistente (retorna 0 em caso de sucesso)
+void telemetryPublish(TelemetrySegment* segment, const TelemetrySnapshot* snapshot);
+int telemetryRead(TelemetrySegment* segment, TelemetrySnapshot* snapshot);
+
+// Anel de comandos. Retornam 0 em caso de sucesso, -1 se o anel estiver cheio/vazio.
+int telemetrySendCommand(TelemetrySegment* segment, const TelemetryCommand* command);
+int telemetryPollCommand(TelemetrySegment* segment, TelemetryCommand* command);
+
+// Acumula uma ativação nas estatísticas de temporização
+void updateTimingStats(TaskTimingStats* stats, double period_ms, double exec_ms, double latency_ms, int missed);
+
+// Mesma acumulação sob o seqlock da tarefa (escritor único) e a leitura correspondente (0 em caso de sucesso)
+void telemetryRecordActivation(TaskStatsCell* cell, double period_ms, double exec_ms, double latency_ms, int missed);
+int telemetryReadStats(TaskStatsCell* cell, TaskTimingStats* stats);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,90 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+
+//------------------------------------------------------------------
+// Constantes
+//------------------------------------------------------------------
+
+#define TRACE_MAGIC 0x52505452u      // "RTPR"
+#define TRACE_VERSION 2u
+#define TRACE_MAX_VALUES 3
+
+// Sinais publicados pelas tarefas (e o marcador de início de ativação)
+typedef enum {
+    TRACE_SIG_ACTIVATION,   // início de uma ativação de `task` (sem valores)
+    TRACE_SIG_TIME,         // [t]
+    TRACE_SIG_REF,          // [xref, yref]
+    TRACE_SIG_YM_X,         // [ymx, ymx_dot]
+    TRACE_SIG_YM_Y,         // [ymy, ymy_dot]
+    TRACE_SIG_V,            // [v1, v2]
+    TRACE_SIG_U,            // [v, w]
+    TRACE_SIG_X_STATE,      // [xc, yc, theta]
+    TRACE_SIG_Y,            // [y1, y2]
+    TRACE_SIG_ALPHA,        // [alpha1, alpha2]
+    TRACE_SIG_YM,           // [ymx, ymy] (lido pelo controle)
+    TRACE_SIG_YM_DOT,       // [ymx_dot, ymy_dot] (lido pelo controle)
+    TRACE_NUM_SIGNALS
+} TraceSignal;
+
+/*
+ * Ligado em `signal` nos registros de entrada: o valor que a tarefa leu,
+ * gravado dentro da mesma seção crítica da leitura. O replay usa essas
+ * entradas em vez do último valor publicado antes da ativação.
+ */
+#define TRACE_INPUT_FLAG 0x80u
+
+//------------------------------------------------------------------
+// Estruturas
+//------------------------------------------------------------------
+
+// Registro de tamanho fixo (40 bytes) gravado como está no arquivo
+typedef struct {
+    uint64_t timestamp_ns;   // CLOCK_MONOTONIC desde o início da gravação
+    uint32_t sequence;       // ordem global de publicação
+    uint8_t signal;          // TraceSignal, com TRACE_INPUT_FLAG nas entradas
+    uint8_t count;           // valores válidos em values
+    uint16_t task;           // tarefa que publicou
+    double values[TRACE_MAX_VALUES];
+} TraceRecord;
+
+// Cabeçalho do arquivo, seguido de `count` registros
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+    uint64_t dropped;        // registros perdidos por falta de espaço no buffer
+} TraceHeader;
+
+/*
+ * Gravador em memória: o buffer é alocado antes do início das tarefas e cada
+ * publicação reserva sua posição com um incremento atômico, sem travas nem
+ * E/S no caminho de tempo real. O arquivo só é escrito ao final.
+ */
+typedef struct {
+    TraceRecord* records;
+    size_t capacity;
+    atomic_size_t next;
+    struct timespec start;
+} TraceRecorder;
+
+
+//------------------------------------------------------------------
+// Declaração das Funções
+//------------------------------------------------------------------
+
+// Gravação
+TraceRecorder* createTraceRecorder(size_t capacity);
+void freeTraceRecorder(TraceRecorder* recorder);
+void traceRecord(TraceRecorder* recorder, int signal, int task, const double* values, int count);
+int saveTrace(TraceRecorder* recorder, const char* path);
+
+// Leitura: retorna os registros em ordem de sequência (liberar com free) ou NULL se o
+// cabeçalho não bater com o tamanho do arquivo ou algum registro tiver sinal ou count inválido
+TraceRecord* loadTrace(const char* path, size_t* count);
+
+#endif // TRACE_H
@@ -0,0 +1,329 @@
+#include <math.h>
+#include <stddef.h>
+#include "batchedMatrix.h"
+
+/*
+ * Cada kernel percorre o lote com um único laço sobre i. O corpo carrega os
+ * elementos do problema i em variáveis locais, aplica a fórmula fechada e grava
+ * o resultado; como cada elemento é contíguo ao longo do lote e não há desvios
+ * dependentes dos dados, o compilador vetoriza o laço entre problemas.
+ * A contagem de singulares é acumulada em double para que o laço inteiro tenha
+ * um único tipo e continue vetorizável.
+ */
+
+// Elemento (r, c) de uma matriz K x K e elemento r de um vetor, no problema i
+#define AT(M, K, r, c) M[(size_t)((r) * (K) + (c)) * count + i]
+#define VAT(v, r) v[(size_t)(r) * count + i]
+
+//------------------------------------------------------------------
+// Funções Auxiliares
+//------------------------------------------------------------------
+
+// 1 se o problema é singular, 0 caso contrário
+static inline double singularMask(double d) {
+    return (fabs(d) < BATCH_SINGULAR_EPS) ? 1.0 : 0.0;
+}
+
+// 1/d, ou 0 se o problema for singular. Sem seleção: no caso singular
+// |d| < 1, então d + 1 nunca é zero.
+static inline double inverseScale(double d, double singular) {
+    return (1.0 - singular) / (d + singular);
+}
+
+//------------------------------------------------------------------
+// 2x2
+//------------------------------------------------------------------
+
+#define LOAD_2X2(M)                                           \
+    double a00 = AT(M, 2, 0, 0), a01 = AT(M, 2, 0, 1);        \
+    double a10 = AT(M, 2, 1, 0), a11 = AT(M, 2, 1, 1)
+
+void batchDet2x2(int count, const double* restrict A, double* restrict det) {
+    for (int i = 0; i < count; i++) {
+        LOAD_2X2(A);
+        det[i] = a00 * a11 - a01 * a10;
+    }
+}
+
+int batchInverse2x2(int count, const double* restrict A, double* restrict Ainv) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_2X2(A);
+        double d = a00 * a11 - a01 * a10;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        AT(Ainv, 2, 0, 0) = a11 * k;
+        AT(Ainv, 2, 0, 1) = -a01 * k;
+        AT(Ainv, 2, 1, 0) = -a10 * k;
+        AT(Ainv, 2, 1, 1) = a00 * k;
+    }
+    return (int)singular;
+}
+
+// Regra de Cramer
+int batchSolve2x2(int count, const double* restrict A, const double* restrict b, double* restrict x) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_2X2(A);
+        double b0 = VAT(b, 0), b1 = VAT(b, 1);
+        double d = a00 * a11 - a01 * a10;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        VAT(x, 0) = (a11 * b0 - a01 * b1) * k;
+        VAT(x, 1) = (a00 * b1 - a10 * b0) * k;
+    }
+    return (int)singular;
+}
+
+void batchMultiply2x2(int count, const double* restrict A, const double* restrict B, double* restrict C) {
+    for (int i = 0; i < count; i++) {
+        LOAD_2X2(A);
+        double b00 = AT(B, 2, 0, 0), b01 = AT(B, 2, 0, 1);
+        double b10 = AT(B, 2, 1, 0), b11 = AT(B, 2, 1, 1);
+
+        AT(C, 2, 0, 0) = a00 * b00 + a01 * b10;
+        AT(C, 2, 0, 1) = a00 * b01 + a01 * b11;
+        AT(C, 2, 1, 0) = a10 * b00 + a11 * b10;
+        AT(C, 2, 1, 1) = a10 * b01 + a11 * b11;
+    }
+}
+
+void batchMatVec2x2(int count, const double* restrict A, const double* restrict x, double* restrict y) {
+    for (int i = 0; i < count; i++) {
+        LOAD_2X2(A);
+        double x0 = VAT(x, 0), x1 = VAT(x, 1);
+
+        VAT(y, 0) = a00 * x0 + a01 * x1;
+        VAT(y, 1) = a10 * x0 + a11 * x1;
+    }
+}
+
+//------------------------------------------------------------------
+// 3x3
+//------------------------------------------------------------------
+
+#define LOAD_3X3(M)                                                           \
+    double a00 = AT(M, 3, 0, 0), a01 = AT(M, 3, 0, 1), a02 = AT(M, 3, 0, 2);  \
+    double a10 = AT(M, 3, 1, 0), a11 = AT(M, 3, 1, 1), a12 = AT(M, 3, 1, 2);  \
+    double a20 = AT(M, 3, 2, 0), a21 = AT(M, 3, 2, 1), a22 = AT(M, 3, 2, 2)
+
+// Cofatores da primeira coluna e o determinante expandido por ela
+#define COFACTORS_3X3                        \
+    double c00 = a11 * a22 - a12 * a21;      \
+    double c10 = a12 * a20 - a10 * a22;      \
+    double c20 = a10 * a21 - a11 * a20;      \
+    double d = a00 * c00 + a01 * c10 + a02 * c20
+
+void batchDet3x3(int count, const double* restrict A, double* restrict det) {
+    for (int i = 0; i < count; i++) {
+        LOAD_3X3(A);
+        COFACTORS_3X3;
+        det[i] = d;
+    }
+}
+
+int batchInverse3x3(int count, const double* restrict A, double* restrict Ainv) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_3X3(A);
+        COFACTORS_3X3;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        // Adjunta (transposta dos cofatores) escalada por 1/det
+        AT(Ainv, 3, 0, 0) = c00 * k;
+        AT(Ainv, 3, 0, 1) = (a02 * a21 - a01 * a22) * k;
+        AT(Ainv, 3, 0, 2) = (a01 * a12 - a02 * a11) * k;
+        AT(Ainv, 3, 1, 0) = c10 * k;
+        AT(Ainv, 3, 1, 1) = (a00 * a22 - a02 * a20) * k;
+        AT(Ainv, 3, 1, 2) = (a02 * a10 - a00 * a12) * k;
+        AT(Ainv, 3, 2, 0) = c20 * k;
+        AT(Ainv, 3, 2, 1) = (a01 * a20 - a00 * a21) * k;
+        AT(Ainv, 3, 2, 2) = (a00 * a11 - a01 * a10) * k;
+    }
+    return (int)singular;
+}
+
+// Regra de Cramer: x_j = det(A com a coluna j trocada por b) / det(A)
+int batchSolve3x3(int count, const double* restrict A, const double* restrict b, double* restrict x) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_3X3(A);
+        double b0 = VAT(b, 0), b1 = VAT(b, 1), b2 = VAT(b, 2);
+        COFACTORS_3X3;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        VAT(x, 0) = (b0 * c00 + a01 * (a12 * b2 - b1 * a22) + a02 * (b1 * a21 - a11 * b2)) * k;
+        VAT(x, 1) = (a00 * (b1 * a22 - a12 * b2) + b0 * c10 + a02 * (a10 * b2 - b1 * a20)) * k;
+        VAT(x, 2) = (a00 * (a11 * b2 - b1 * a21) + a01 * (b1 * a20 - a10 * b2) + b0 * c20) * k;
+    }
+    return (int)singular;
+}
+
+void batchMultiply3x3(int count, const double* restrict A, const double* restrict B, double* restrict C) {
+    for (int i = 0; i < count; i++) {
+        LOAD_3X3(A);
+        double b00 = AT(B, 3, 0, 0), b01 = AT(B, 3, 0, 1), b02 = AT(B, 3, 0, 2);
+        double b10 = AT(B, 3, 1, 0), b11 = AT(B, 3, 1, 1), b12 = AT(B, 3, 1, 2);
+        double b20 = AT(B, 3, 2, 0), b21 = AT(B, 3, 2, 1), b22 = AT(B, 3, 2, 2);
+
+        AT(C, 3, 0, 0) = a00 * b00 + a01 * b10 + a02 * b20;
+        AT(C, 3, 0, 1) = a00 * b01 + a01 * b11 + a02 * b21;
+        AT(C, 3, 0, 2) = a00 * b02 + a01 * b12 + a02 * b22;
+        AT(C, 3, 1, 0) = a10 * b00 + a11 * b10 + a12 * b20;
+        AT(C, 3, 1, 1) = a10 * b01 + a11 * b11 + a12 * b21;
+        AT(C, 3, 1, 2) = a10 * b02 + a11 * b12 + a12 * b22;
+        AT(C, 3, 2, 0) = a20 * b00 + a21 * b10 + a22 * b20;
+        AT(C, 3, 2, 1) = a20 * b01 + a21 * b11 + a22 * b21;
+        AT(C, 3, 2, 2) = a20 * b02 + a21 * b12 + a22 * b22;
+    }
+}
+
+void batchMatVec3x3(int count, const double* restrict A, const double* restrict x, double* restrict y) {
+    for (int i = 0; i < count; i++) {
+        LOAD_3X3(A);
+        double x0 = VAT(x, 0), x1 = VAT(x, 1), x2 = VAT(x, 2);
+
+        VAT(y, 0) = a00 * x0 + a01 * x1 + a02 * x2;
+        VAT(y, 1) = a10 * x0 + a11 * x1 + a12 * x2;
+        VAT(y, 2) = a20 * x0 + a21 * x1 + a22 * x2;
+    }
+}
+
+//------------------------------------------------------------------
+// 4x4
+//------------------------------------------------------------------
+
+#define LOAD_4X4(M)                                                                                 \
+    double a00 = AT(M, 4, 0, 0), a01 = AT(M, 4, 0, 1), a02 = AT(M, 4, 0, 2), a03 = AT(M, 4, 0, 3);  \
+    double a10 = AT(M, 4, 1, 0), a11 = AT(M, 4, 1, 1), a12 = AT(M, 4, 1, 2), a13 = AT(M, 4, 1, 3);  \
+    double a20 = AT(M, 4, 2, 0), a21 = AT(M, 4, 2, 1), a22 = AT(M, 4, 2, 2), a23 = AT(M, 4, 2, 3);  \
+    double a30 = AT(M, 4, 3, 0), a31 = AT(M, 4, 3, 1), a32 = AT(M, 4, 3, 2), a33 = AT(M, 4, 3, 3)
+
+// Expansão de Laplace pelas duas primeiras linhas: menores 2x2 das linhas 0-1
+// (s0..s5) e os menores complementares das linhas 2-3 (c0..c5)
+#define MINORS_4X4                               \
+    double s0 = a00 * a11 - a10 * a01;           \
+    double s1 = a00 * a12 - a10 * a02;           \
+    double s2 = a00 * a13 - a10 * a03;           \
+    double s3 = a01 * a12 - a11 * a02;           \
+    double s4 = a01 * a13 - a11 * a03;           \
+    double s5 = a02 * a13 - a12 * a03;           \
+    double c5 = a22 * a33 - a32 * a23;           \
+    double c4 = a21 * a33 - a31 * a23;           \
+    double c3 = a21 * a32 - a31 * a22;           \
+    double c2 = a20 * a33 - a30 * a23;           \
+    double c1 = a20 * a32 - a30 * a22;           \
+    double c0 = a20 * a31 - a30 * a21;           \
+    double d = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0
+
+// Adjunta em j00..j33 (ainda não escalada por 1/det)
+#define ADJUGATE_4X4                                   \
+    double j00 = a11 * c5 - a12 * c4 + a13 * c3;       \
+    double j01 = -a01 * c5 + a02 * c4 - a03 * c3;      \
+    double j02 = a31 * s5 - a32 * s4 + a33 * s3;       \
+    double j03 = -a21 * s5 + a22 * s4 - a23 * s3;      \
+    double j10 = -a10 * c5 + a12 * c2 - a13 * c1;      \
+    double j11 = a00 * c5 - a02 * c2 + a03 * c1;       \
+    double j12 = -a30 * s5 + a32 * s2 - a33 * s1;      \
+    double j13 = a20 * s5 - a22 * s2 + a23 * s1;       \
+    double j20 = a10 * c4 - a11 * c2 + a13 * c0;       \
+    double j21 = -a00 * c4 + a01 * c2 - a03 * c0;      \
+    double j22 = a30 * s4 - a31 * s2 + a33 * s0;       \
+    double j23 = -a20 * s4 + a21 * s2 - a23 * s0;      \
+    double j30 = -a10 * c3 + a11 * c1 - a12 * c0;      \
+    double j31 = a00 * c3 - a01 * c1 + a02 * c0;       \
+    double j32 = -a30 * s3 + a31 * s1 - a32 * s0;      \
+    double j33 = a20 * s3 - a21 * s1 + a22 * s0
+
+void batchDet4x4(int count, const double* restrict A, double* restrict det) {
+    for (int i = 0; i < count; i++) {
+        LOAD_4X4(A);
+        MINORS_4X4;
+        det[i] = d;
+    }
+}
+
+int batchInverse4x4(int count, const double* restrict A, double* restrict Ainv) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_4X4(A);
+        MINORS_4X4;
+        ADJUGATE_4X4;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        AT(Ainv, 4, 0, 0) = j00 * k; AT(Ainv, 4, 0, 1) = j01 * k; AT(Ainv, 4, 0, 2) = j02 * k; AT(Ainv, 4, 0, 3) = j03 * k;
+        AT(Ainv, 4, 1, 0) = j10 * k; AT(Ainv, 4, 1, 1) = j11 * k; AT(Ainv, 4, 1, 2) = j12 * k; AT(Ainv, 4, 1, 3) = j13 * k;
+        AT(Ainv, 4, 2, 0) = j20 * k; AT(Ainv, 4, 2, 1) = j21 * k; AT(Ainv, 4, 2, 2) = j22 * k; AT(Ainv, 4, 2, 3) = j23 * k;
+        AT(Ainv, 4, 3, 0) = j30 * k; AT(Ainv, 4, 3, 1) = j31 * k; AT(Ainv, 4, 3, 2) = j32 * k; AT(Ainv, 4, 3, 3) = j33 * k;
+    }
+    return (int)singular;
+}
+
+// x = adj(A) b / det(A)
+int batchSolve4x4(int count, const double* restrict A, const double* restrict b, double* restrict x) {
+    double singular = 0.0;
+    for (int i = 0; i < count; i++) {
+        LOAD_4X4(A);
+        double b0 = VAT(b, 0), b1 = VAT(b, 1), b2 = VAT(b, 2), b3 = VAT(b, 3);
+        MINORS_4X4;
+        ADJUGATE_4X4;
+        double s = singularMask(d);
+        double k = inverseScale(d, s);
+        singular += s;
+
+        VAT(x, 0) = (j00 * b0 + j01 * b1 + j02 * b2 + j03 * b3) * k;
+        VAT(x, 1) = (j10 * b0 + j11 * b1 + j12 * b2 + j13 * b3) * k;
+        VAT(x, 2) = (j20 * b0 + j21 * b1 + j22 * b2 + j23 * b3) * k;
+        VAT(x, 3) = (j30 * b0 + j31 * b1 + j32 * b2 + j33 * b3) * k;
+    }
+    return (int)singular;
+}
+
+void batchMultiply4x4(int count, const double* restrict A, const double* restrict B, double* restrict C) {
+    for (int i = 0; i < count; i++) {
+        LOAD_4X4(A);
+        double b00 = AT(B, 4, 0, 0), b01 = AT(B, 4, 0, 1), b02 = AT(B, 4, 0, 2), b03 = AT(B, 4, 0, 3);
+        double b10 = AT(B, 4, 1, 0), b11 = AT(B, 4, 1, 1), b12 = AT(B, 4, 1, 2), b13 = AT(B, 4, 1, 3);
+        double b20 = AT(B, 4, 2, 0), b21 = AT(B, 4, 2, 1), b22 = AT(B, 4, 2, 2), b23 = AT(B, 4, 2, 3);
+        double b30 = AT(B, 4, 3, 0), b31 = AT(B, 4, 3, 1), b32 = AT(B, 4, 3, 2), b33 = AT(B, 4, 3, 3);
+
+        AT(C, 4, 0, 0) = a00 * b00 + a01 * b10 + a02 * b20 + a03 * b30;
+        AT(C, 4, 0, 1) = a00 * b01 + a01 * b11 + a02 * b21 + a03 * b31;
+        AT(C, 4, 0, 2) = a00 * b02 + a01 * b12 + a02 * b22 + a03 * b32;
+        AT(C, 4, 0, 3) = a00 * b03 + a01 * b13 + a02 * b23 + a03 * b33;
+        AT(C, 4, 1, 0) = a10 * b00 + a11 * b10 + a12 * b20 + a13 * b30;
+        AT(C, 4, 1, 1) = a10 * b01 + a11 * b11 + a12 * b21 + a13 * b31;
+        AT(C, 4, 1, 2) = a10 * b02 + a11 * b12 + a12 * b22 + a13 * b32;
+        AT(C, 4, 1, 3) = a10 * b03 + a11 * b13 + a12 * b23 + a13 * b33;
+        AT(C, 4, 2, 0) = a20 * b00 + a21 * b10 + a22 * b20 + a23 * b30;
+        AT(C, 4, 2, 1) = a20 * b01 + a21 * b11 + a22 * b21 + a23 * b31;
+        AT(C, 4, 2, 2) = a20 * b02 + a21 * b12 + a22 * b22 + a23 * b32;
+        AT(C, 4, 2, 3) = a20 * b03 + a21 * b13 + a22 * b23 + a23 * b33;
+        AT(C, 4, 3, 0) = a30 * b00 + a31 * b10 + a32 * b20 + a33 * b30;
+        AT(C, 4, 3, 1) = a30 * b01 + a31 * b11 + a32 * b21 + a33 * b31;
+        AT(C, 4, 3, 2) = a30 * b02 + a31 * b12 + a32 * b22 + a33 * b32;
+        AT(C, 4, 3, 3) = a30 * b03 + a31 * b13 + a32 * b23 + a33 * b33;
+    }
+}
+
+void batchMatVec4x4(int count, const double* restrict A, const double* restrict x, double* restrict y) {
+    for (int i = 0; i < count; i++) {
+        LOAD_4X4(A);
+        double x0 = VAT(x, 0), x1 = VAT(x, 1), x2 = VAT(x, 2), x3 = VAT(x, 3);
+
+        VAT(y, 0) = a00 * x0 + a01 * x1 + a02 * x2 + a03 * x3;
+        VAT(y, 1) = a10 * x0 + a11 * x1 + a12 * x2 + a13 * x3;
+        VAT(y, 2) = a20 * x0 + a21 * x1 + a22 * x2 + a23 * x3;
+        VAT(y, 3) = a30 * x0 + a31 * x1 + a32 * x2 + a33 * x3;
+    }
+}
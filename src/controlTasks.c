@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "controlTasks.h"
+#include "batchedMatrix.h"
+#include "robotModel.h"
+
+// --- Variáveis Compartilhadas e Mutexes ---
+double current_time = 0.0;
+ProfiledMutex time_mutex;
+
+// Estado do robô: x_state = [xc, yc, theta]T
+Matrix* x_state;
+ProfiledMutex x_state_mutex;
+
+// Saída do robô: y_output = [y1, y2]T
+Matrix* y_output;
+ProfiledMutex y_output_mutex;
+
+// Entrada de controle linearizada: v_input = [v1, v2]T
+Matrix* v_input;
+ProfiledMutex v_input_mutex;
+
+// Entrada do robô: u_input = [v, w]T
+Matrix* u_input;
+ProfiledMutex u_input_mutex;
+
+// Saídas do modelo de referência: ym = [ymx, ymy]T
+Matrix* ym_output;
+ProfiledMutex ym_output_mutex;
+
+// Derivadas do modelo de referência: ym_dot = [ymx_dot, ymy_dot]T
+Matrix* ym_dot_output;
+ProfiledMutex ym_dot_output_mutex;
+
+// Referência: ref = [xref, yref]T
+Matrix* ref_input;
+ProfiledMutex ref_input_mutex;
+
+// Parâmetros do controlador
+double alpha1 = 3.0;
+double alpha2 = 3.0;
+ProfiledMutex alpha_mutex;
+
+// Estado interno dos modelos de referência
+static double ymx_state = 0.0;
+static double ymy_state = 0.0;
+
+// Matrizes de trabalho da simulação do robô (alocadas uma única vez)
+static Matrix* robot_B;   // B(theta), 3x2
+static Matrix* robot_u;   // cópia local de u, 2x1
+
+ProfiledMutex* const shared_locks[NUM_SHARED_LOCKS] = {
+    &time_mutex, &x_state_mutex, &y_output_mutex, &v_input_mutex, &u_input_mutex,
+    &ym_output_mutex, &ym_dot_output_mutex, &ref_input_mutex, &alpha_mutex,
+};
+static const char* const shared_lock_names[NUM_SHARED_LOCKS] = {
+    "time", "x_state", "y_output", "v_input", "u_input", "ym_output", "ym_dot_output", "ref_input", "alpha",
+};
+
+int shared_locking = 1;
+
+TraceRecorder* recorder = NULL;
+
+// --- Gerenciamento do Estado Compartilhado ---
+
+int init_shared_state(void) {
+    // Inicialização dos Mutexes: sem PTHREAD_PRIO_INHERIT a inversão de prioridade fica sem limite
+    for (int i = 0; i < NUM_SHARED_LOCKS; i++) {
+        int err = profiledMutexInit(shared_locks[i], shared_lock_names[i]);
+        if (err != 0) {
+            fprintf(stderr, "Erro ao criar a trava %s: %s\n", shared_lock_names[i], strerror(err));
+            while (i-- > 0) profiledMutexDestroy(shared_locks[i]);
+            return -1;
+        }
+    }
+
+    // Inicialização das variáveis
+    x_state = createMatrix(3, 1); // [xc, yc, theta]
+    y_output = createMatrix(2, 1); // [y1, y2]
+    v_input = createMatrix(2, 1);
+    u_input = createMatrix(2, 1);
+    ym_output = createMatrix(2, 1);
+    ym_dot_output = createMatrix(2, 1);
+    ref_input = createMatrix(2, 1);
+    robot_B = createMatrix(3, 2);
+    robot_u = createMatrix(2, 1);
+    return 0;
+}
+
+void free_shared_state(void) {
+    freeMatrix(x_state);
+    freeMatrix(y_output);
+    freeMatrix(v_input);
+    freeMatrix(u_input);
+    freeMatrix(ym_output);
+    freeMatrix(ym_dot_output);
+    freeMatrix(ref_input);
+    freeMatrix(robot_B);
+    freeMatrix(robot_u);
+    profiledMutexDestroy(&time_mutex);
+    profiledMutexDestroy(&x_state_mutex);
+    profiledMutexDestroy(&y_output_mutex);
+    profiledMutexDestroy(&v_input_mutex);
+    profiledMutexDestroy(&u_input_mutex);
+    profiledMutexDestroy(&ym_output_mutex);
+    profiledMutexDestroy(&ym_dot_output_mutex);
+    profiledMutexDestroy(&ref_input_mutex);
+    profiledMutexDestroy(&alpha_mutex);
+}
+
+void set_ref_model_state(double ymx, double ymy) {
+    ymx_state = ymx;
+    ymy_state = ymy;
+}
+
+void record_signal(int signal, int task, const double* values, int count) {
+    if (recorder) traceRecord(recorder, signal, task, values, count);
+}
+
+void record_input(int signal, int task, const double* values, int count) {
+    if (recorder) traceRecord(recorder, signal | TRACE_INPUT_FLAG, task, values, count);
+}
+
+// --- Implementação das Tarefas ---
+
+void reference_generation_step(void) {
+    lock_shared(&time_mutex);
+    double t = current_time;
+    record_input(TRACE_SIG_TIME, TASK_REF_GEN, &t, 1);
+    unlock_shared(&time_mutex);
+
+    double xref_val, yref_val;
+    referenceAt(t, &xref_val, &yref_val);
+
+    lock_shared(&ref_input_mutex);
+    ref_input->data[0][0] = xref_val;
+    ref_input->data[1][0] = yref_val;
+    double ref[2] = {xref_val, yref_val};
+    record_signal(TRACE_SIG_REF, TASK_REF_GEN, ref, 2);
+    unlock_shared(&ref_input_mutex);
+}
+
+void ref_model_x_step(void) {
+    double dt = REF_MODEL_X_PERIOD_MS / 1000.0;
+
+    lock_shared(&ref_input_mutex);
+    double ref[2] = {ref_input->data[0][0], ref_input->data[1][0]};
+    record_input(TRACE_SIG_REF, TASK_REF_MODEL_X, ref, 2);
+    unlock_shared(&ref_input_mutex);
+    double xref = ref[0];
+
+    lock_shared(&alpha_mutex);
+    double alphas[2] = {alpha1, alpha2};
+    record_input(TRACE_SIG_ALPHA, TASK_REF_MODEL_X, alphas, 2);
+    unlock_shared(&alpha_mutex);
+    double a1 = alphas[0];
+
+    double ymx_dot = refModelStep(&ymx_state, xref, a1, dt);
+
+    lock_shared(&ym_output_mutex);
+    ym_output->data[0][0] = ymx_state;
+    unlock_shared(&ym_output_mutex);
+
+    lock_shared(&ym_dot_output_mutex);
+    ym_dot_output->data[0][0] = ymx_dot;
+    double ym[2] = {ymx_state, ymx_dot};
+    record_signal(TRACE_SIG_YM_X, TASK_REF_MODEL_X, ym, 2);
+    unlock_shared(&ym_dot_output_mutex);
+}
+
+void ref_model_y_step(void) {
+    double dt = REF_MODEL_Y_PERIOD_MS / 1000.0;
+
+    lock_shared(&ref_input_mutex);
+    double ref[2] = {ref_input->data[0][0], ref_input->data[1][0]};
+    record_input(TRACE_SIG_REF, TASK_REF_MODEL_Y, ref, 2);
+    unlock_shared(&ref_input_mutex);
+    double yref = ref[1];
+
+    lock_shared(&alpha_mutex);
+    double alphas[2] = {alpha1, alpha2};
+    record_input(TRACE_SIG_ALPHA, TASK_REF_MODEL_Y, alphas, 2);
+    unlock_shared(&alpha_mutex);
+    double a2 = alphas[1];
+
+    double ymy_dot = refModelStep(&ymy_state, yref, a2, dt);
+
+    lock_shared(&ym_output_mutex);
+    ym_output->data[1][0] = ymy_state;
+    unlock_shared(&ym_output_mutex);
+
+    lock_shared(&ym_dot_output_mutex);
+    ym_dot_output->data[1][0] = ymy_dot;
+    double ym[2] = {ymy_state, ymy_dot};
+    record_signal(TRACE_SIG_YM_Y, TASK_REF_MODEL_Y, ym, 2);
+    unlock_shared(&ym_dot_output_mutex);
+}
+
+void control_step(void) {
+    lock_shared(&y_output_mutex);
+    double y[2] = {y_output->data[0][0], y_output->data[1][0]};
+    record_input(TRACE_SIG_Y, TASK_CONTROL, y, 2);
+    unlock_shared(&y_output_mutex);
+    double y1 = y[0];
+    double y2 = y[1];
+
+    lock_shared(&ym_output_mutex);
+    double ym[2] = {ym_output->data[0][0], ym_output->data[1][0]};
+    record_input(TRACE_SIG_YM, TASK_CONTROL, ym, 2);
+    unlock_shared(&ym_output_mutex);
+    double ymx = ym[0];
+    double ymy = ym[1];
+
+    lock_shared(&ym_dot_output_mutex);
+    double ym_dot[2] = {ym_dot_output->data[0][0], ym_dot_output->data[1][0]};
+    record_input(TRACE_SIG_YM_DOT, TASK_CONTROL, ym_dot, 2);
+    unlock_shared(&ym_dot_output_mutex);
+    double ymx_dot = ym_dot[0];
+    double ymy_dot = ym_dot[1];
+
+    lock_shared(&alpha_mutex);
+    double alphas[2] = {alpha1, alpha2};
+    record_input(TRACE_SIG_ALPHA, TASK_CONTROL, alphas, 2);
+    unlock_shared(&alpha_mutex);
+    double a1 = alphas[0];
+    double a2 = alphas[1];
+
+    double v1 = controlLaw(ymx_dot, ymx, y1, a1);
+    double v2 = controlLaw(ymy_dot, ymy, y2, a2);
+
+    lock_shared(&v_input_mutex);
+    v_input->data[0][0] = v1;
+    v_input->data[1][0] = v2;
+    double v[2] = {v1, v2};
+    record_signal(TRACE_SIG_V, TASK_CONTROL, v, 2);
+    unlock_shared(&v_input_mutex);
+}
+
+void linearization_step(void) {
+    lock_shared(&x_state_mutex);
+    double x[3] = {x_state->data[0][0], x_state->data[1][0], x_state->data[2][0]};
+    record_input(TRACE_SIG_X_STATE, TASK_LINEARIZATION, x, 3);
+    unlock_shared(&x_state_mutex);
+    double theta = x[2];
+
+    // Lote de um único problema: L (2x2) e v no layout intercalado
+    double v[2];
+    lock_shared(&v_input_mutex);
+    v[0] = v_input->data[0][0];
+    v[1] = v_input->data[1][0];
+    record_input(TRACE_SIG_V, TASK_LINEARIZATION, v, 2);
+    unlock_shared(&v_input_mutex);
+
+    double L[4] = {
+        cos(theta), -R_ROBOT * sin(theta),
+        sin(theta), R_ROBOT * cos(theta),
+    };
+
+    // u = L^-1 v, sem alocação; L é singular somente se R_ROBOT == 0
+    double u[2];
+    if (batchSolve2x2(1, L, v, u) == 0) {
+        lock_shared(&u_input_mutex);
+        u_input->data[0][0] = u[0];
+        u_input->data[1][0] = u[1];
+        record_signal(TRACE_SIG_U, TASK_LINEARIZATION, u, 2);
+        unlock_shared(&u_input_mutex);
+    }
+}
+
+void robot_simulation_step(void) {
+    double dt = ROBOT_SIM_PERIOD_MS / 1000.0;
+
+    lock_shared(&u_input_mutex);
+    double u[2] = {u_input->data[0][0], u_input->data[1][0]};
+    record_input(TRACE_SIG_U, TASK_ROBOT_SIM, u, 2);
+    unlock_shared(&u_input_mutex);
+    robot_u->data[0][0] = u[0]; // v
+    robot_u->data[1][0] = u[1]; // w
+
+    lock_shared(&x_state_mutex);
+    double x_before[3] = {x_state->data[0][0], x_state->data[1][0], x_state->data[2][0]};
+    record_input(TRACE_SIG_X_STATE, TASK_ROBOT_SIM, x_before, 3);
+    double theta = x_before[2];
+
+    // x_dot = B(theta) * u, com B = [cos 0; sin 0; 0 1]
+    robot_B->data[0][0] = cos(theta);
+    robot_B->data[1][0] = sin(theta);
+    robot_B->data[2][1] = 1.0;
+
+    // Atualiza o estado em uma única passada: x = x + dt * B(theta) * u
+    gemv(dt, robot_B, robot_u, 1.0, x_state);
+
+    // Calcula a nova saída y
+    double new_xc = x_state->data[0][0];
+    double new_yc = x_state->data[1][0];
+    double new_theta = x_state->data[2][0];
+    double x_values[3] = {new_xc, new_yc, new_theta};
+    record_signal(TRACE_SIG_X_STATE, TASK_ROBOT_SIM, x_values, 3);
+    unlock_shared(&x_state_mutex);
+
+    lock_shared(&y_output_mutex);
+    y_output->data[0][0] = new_xc + R_ROBOT * cos(new_theta);
+    y_output->data[1][0] = new_yc + R_ROBOT * sin(new_theta);
+    double y_values[2] = {y_output->data[0][0], y_output->data[1][0]};
+    record_signal(TRACE_SIG_Y, TASK_ROBOT_SIM, y_values, 2);
+    unlock_shared(&y_output_mutex);
+
+    lock_shared(&time_mutex);
+    record_input(TRACE_SIG_TIME, TASK_ROBOT_SIM, &current_time, 1);
+    current_time += dt;
+    record_signal(TRACE_SIG_TIME, TASK_ROBOT_SIM, &current_time, 1);
+    unlock_shared(&time_mutex);
+}
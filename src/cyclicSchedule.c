@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <string.h>
+#include "cyclicSchedule.h"
+
+//------------------------------------------------------------------
+// Funções Auxiliares
+//------------------------------------------------------------------
+
+static long gcd(long a, long b) {
+    while (b != 0) {
+        long r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------
+// Geração do Escalonamento
+//------------------------------------------------------------------
+
+int buildCyclicSchedule(const int* periods_ms, int num_tasks, CyclicSchedule* schedule) {
+    if (num_tasks <= 0 || num_tasks > CYCLIC_MAX_TASKS) return -1;
+
+    int minor = 0;
+    long major = 1;
+    for (int i = 0; i < num_tasks; i++) {
+        if (periods_ms[i] <= 0) return -1;
+        minor = (int)gcd(minor, periods_ms[i]);
+        major = major / gcd(major, periods_ms[i]) * periods_ms[i];   // MMC
+        if (major / minor > CYCLIC_MAX_FRAMES) return -1;
+    }
+
+    memset(schedule, 0, sizeof(*schedule));
+    schedule->minor_ms = minor;
+    schedule->major_ms = (int)major;
+    schedule->num_frames = (int)(major / minor);
+    schedule->num_tasks = num_tasks;
+
+    // A tarefa i é liberada nos quadros cujo início é múltiplo do seu período
+    for (int f = 0; f < schedule->num_frames; f++) {
+        int t = f * minor;
+        for (int i = 0; i < num_tasks; i++) {
+            if (t % periods_ms[i] == 0) {
+                schedule->frame_tasks[f][schedule->frame_count[f]++] = i;
+            }
+        }
+    }
+    return 0;
+}
+
+void printCyclicSchedule(const CyclicSchedule* schedule, const char* const* names) {
+    printf("Quadro menor: %d ms | Quadro maior (hiperperíodo): %d ms | %d quadros\n",
+           schedule->minor_ms, schedule->major_ms, schedule->num_frames);
+    for (int f = 0; f < schedule->num_frames; f++) {
+        if (schedule->frame_count[f] == 0) continue;
+        printf("  t = %4d ms:", f * schedule->minor_ms);
+        for (int k = 0; k < schedule->frame_count[f]; k++) printf(" %s", names[schedule->frame_tasks[f][k]]);
+        printf("\n");
+    }
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "fleet.h"
+#include "robotModel.h"
+#include "taskPlacement.h"
+
+#define FLEET_NUM_FIELDS 16
+#define FLEET_ALIGNMENT 64
+#define FLEET_START_DELAY_NS 20000000L   // folga entre a criação dos workers e a 1a liberação
+
+//------------------------------------------------------------------
+// Funções de Gerenciamento de Memória
+//------------------------------------------------------------------
+
+FleetState* createFleet(int count) {
+    if (count <= 0) return NULL;
+
+    FleetState* fleet = (FleetState*)calloc(1, sizeof(FleetState));
+    if (fleet == NULL) return NULL;
+
+    // Cada vetor começa em uma fronteira de linha de cache
+    size_t stride = ((size_t)count * sizeof(double) + FLEET_ALIGNMENT - 1) / FLEET_ALIGNMENT * FLEET_ALIGNMENT;
+    void* block = NULL;
+    if (posix_memalign(&block, FLEET_ALIGNMENT, stride * FLEET_NUM_FIELDS) != 0) {
+        free(fleet);
+        return NULL;
+    }
+    memset(block, 0, stride * FLEET_NUM_FIELDS);
+
+    double** fields[FLEET_NUM_FIELDS] = {
+        &fleet->xc, &fleet->yc, &fleet->theta, &fleet->y1, &fleet->y2,
+        &fleet->ymx, &fleet->ymy, &fleet->ymx_dot, &fleet->ymy_dot,
+        &fleet->alpha1, &fleet->alpha2, &fleet->phase,
+        &fleet->v1, &fleet->v2, &fleet->v, &fleet->w,
+    };
+    for (int f = 0; f < FLEET_NUM_FIELDS; f++) {
+        *fields[f] = (double*)((char*)block + f * stride);
+    }
+    fleet->block = (double*)block;
+    fleet->count = count;
+
+    // Robôs espalhados ao longo da trajetória de referência, com os ganhos padrão
+    for (int i = 0; i < count; i++) {
+        fleet->alpha1[i] = 3.0;
+        fleet->alpha2[i] = 3.0;
+        fleet->phase[i] = 10.0 * i / count;
+        robotOutput(fleet->xc[i], fleet->yc[i], fleet->theta[i], &fleet->y1[i], &fleet->y2[i]);
+    }
+    return fleet;
+}
+
+void freeFleet(FleetState* fleet) {
+    if (fleet == NULL) return;
+    free(fleet->block);
+    free(fleet);
+}
+
+//------------------------------------------------------------------
+// Cadeia de Controle em Lote
+//------------------------------------------------------------------
+
+/*
+ * Cada estágio percorre o intervalo inteiro antes do próximo, na mesma ordem
+ * de dependência das tarefas do app_final: referência -> modelo de referência
+ * -> controle -> linearização -> robô.
+ */
+void fleetStep(FleetState* fleet, int begin, int end, double t, double dt) {
+    double* restrict ymx = fleet->ymx;
+    double* restrict ymy = fleet->ymy;
+    double* restrict ymx_dot = fleet->ymx_dot;
+    double* restrict ymy_dot = fleet->ymy_dot;
+    double* restrict v1 = fleet->v1;
+    double* restrict v2 = fleet->v2;
+    const double* restrict y1 = fleet->y1;
+    const double* restrict y2 = fleet->y2;
+    const double* restrict alpha1 = fleet->alpha1;
+    const double* restrict alpha2 = fleet->alpha2;
+
+    for (int i = begin; i < end; i++) {
+        double xref, yref;
+        referenceAt(t + fleet->phase[i], &xref, &yref);
+        ymx_dot[i] = refModelStep(&ymx[i], xref, alpha1[i], dt);
+        ymy_dot[i] = refModelStep(&ymy[i], yref, alpha2[i], dt);
+    }
+
+    for (int i = begin; i < end; i++) {
+        v1[i] = controlLaw(ymx_dot[i], ymx[i], y1[i], alpha1[i]);
+        v2[i] = controlLaw(ymy_dot[i], ymy[i], y2[i], alpha2[i]);
+    }
+
+    for (int i = begin; i < end; i++) {
+        linearizeInput(fleet->theta[i], v1[i], v2[i], &fleet->v[i], &fleet->w[i]);
+    }
+
+    for (int i = begin; i < end; i++) {
+        unicycleStep(&fleet->xc[i], &fleet->yc[i], &fleet->theta[i], fleet->v[i], fleet->w[i], dt);
+        robotOutput(fleet->xc[i], fleet->yc[i], fleet->theta[i], &fleet->y1[i], &fleet->y2[i]);
+    }
+}
+
+//------------------------------------------------------------------
+// Pool de Workers Periódicos
+//------------------------------------------------------------------
+
+typedef struct {
+    FleetState* fleet;
+    const FleetConfig* config;
+    int begin;
+    int end;
+    struct timespec start;     // instante da primeira liberação (comum a todos)
+    double* latencies_us;      // atraso de liberação de cada ativação
+    long activations;
+    long misses;
+    double exec_sum_ms;
+    double exec_max_ms;
+    pthread_t tid;
+} FleetWorker;
+
+static void addNanoseconds(struct timespec* ts, long long ns) {
+    long long total = ts->tv_nsec + ns;
+    ts->tv_sec += total / 1000000000LL;
+    ts->tv_nsec = total % 1000000000LL;
+}
+
+static double elapsedMs(const struct timespec* from, const struct timespec* to) {
+    return (to->tv_sec - from->tv_sec) * 1000.0 + (to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+static void* fleetWorkerThread(void* arg) {
+    FleetWorker* worker = (FleetWorker*)arg;
+    const FleetConfig* config = worker->config;
+    long long period_ns = (long long)config->period_ms * 1000000LL;
+    double dt = config->period_ms / 1000.0;
+    long total = (long)(config->duration_s * 1000.0 / config->period_ms);
+
+    struct timespec release = worker->start;
+    for (long k = 0; k < total; k++) {
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &release, NULL);
+
+        struct timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        fleetStep(worker->fleet, worker->begin, worker->end, k * dt, dt);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double exec_ms = elapsedMs(&begin, &end);
+        worker->latencies_us[k] = elapsedMs(&release, &begin) * 1000.0;
+        worker->exec_sum_ms += exec_ms;
+        if (exec_ms > worker->exec_max_ms) worker->exec_max_ms = exec_ms;
+        worker->activations++;
+
+        addNanoseconds(&release, period_ns);
+        if (elapsedMs(&release, &end) > 0) worker->misses++;
+    }
+    return NULL;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int runFleet(FleetState* fleet, const FleetConfig* config, FleetReport* report) {
+    memset(report, 0, sizeof(FleetReport));
+
+    int workers = config->workers;
+    if (workers > fleet->count) workers = fleet->count;
+    long total = (long)(config->duration_s * 1000.0 / config->period_ms);
+    if (workers <= 0 || total <= 0) return -1;
+    report->workers = workers;
+
+    FleetWorker* pool = (FleetWorker*)calloc(workers, sizeof(FleetWorker));
+    double* latencies = (double*)malloc(workers * total * sizeof(double));
+    if (pool == NULL || latencies == NULL) {
+        free(pool);
+        free(latencies);
+        return -1;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    addNanoseconds(&start, FLEET_START_DELAY_NS);
+
+    long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int created = 0;
+    for (int w = 0; w < workers; w++) {
+        // Particionamento estático em blocos contíguos
+        pool[w].fleet = fleet;
+        pool[w].config = config;
+        pool[w].begin = (int)((long)fleet->count * w / workers);
+        pool[w].end = (int)((long)fleet->count * (w + 1) / workers);
+        pool[w].start = start;
+        pool[w].latencies_us = latencies + w * total;
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (config->pin && ncpus > 0) {
+            TaskPlacement placement = {0};
+            CPU_SET((int)(w % ncpus), &placement.cpus);
+            placement.pinned = 1;
+            applyPlacementAttr(&attr, &placement);
+        }
+        int err = pthread_create(&pool[w].tid, &attr, fleetWorkerThread, &pool[w]);
+        pthread_attr_destroy(&attr);
+        if (err != 0) {
+            fprintf(stderr, "Erro ao criar o worker %d: %s\n", w, strerror(err));
+            break;
+        }
+        created++;
+    }
+
+    double busy_ms = 0.0;
+    long count = 0;
+    for (int w = 0; w < created; w++) {
+        pthread_join(pool[w].tid, NULL);
+
+        report->activations += pool[w].activations;
+        report->misses += pool[w].misses;
+        busy_ms += pool[w].exec_sum_ms;
+        if (pool[w].exec_max_ms > report->exec_max_ms) report->exec_max_ms = pool[w].exec_max_ms;
+
+        double utilization = pool[w].exec_sum_ms / (pool[w].activations * (double)config->period_ms);
+        if (utilization > report->utilization) report->utilization = utilization;
+
+        memmove(latencies + count, pool[w].latencies_us, pool[w].activations * sizeof(double));
+        count += pool[w].activations;
+    }
+
+    if (count > 0) {
+        qsort(latencies, count, sizeof(double), compareDoubles);
+        report->latency_p50_us = latencies[count / 2];
+        report->latency_p99_us = latencies[(count * 99) / 100];
+        report->latency_max_us = latencies[count - 1];
+        report->exec_mean_ms = busy_ms / report->activations;
+        report->steps_per_s = (double)fleet->count * total / (busy_ms / 1000.0);
+    }
+
+    free(latencies);
+    free(pool);
+    return (created == workers) ? 0 : -1;
+}
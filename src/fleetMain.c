@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+#include "fleet.h"
+
+// --- Parâmetros Padrão da Simulação de Frota ---
+#define FLEET_DEFAULT_PERIOD_MS 30
+#define FLEET_DEFAULT_DURATION_S 2.0
+#define FLEET_MAX_SWEEP 100000
+
+void print_usage(const char* program) {
+    printf("Uso: %s [opções]\n", program);
+    printf("  -n, --robots N        número de robôs (padrão: varredura 1, 10, ..., %d)\n", FLEET_MAX_SWEEP);
+    printf("  -w, --workers W       workers periódicos (padrão: número de CPUs)\n");
+    printf("  -p, --period MS       período dos workers (padrão: %d ms)\n", FLEET_DEFAULT_PERIOD_MS);
+    printf("  -d, --duration S      duração de cada medição (padrão: %.1f s)\n", FLEET_DEFAULT_DURATION_S);
+    printf("      --no-pin          não fixa os workers em CPUs\n");
+}
+
+int main(int argc, char* argv[]) {
+    FleetConfig config = {
+        .workers = (int)sysconf(_SC_NPROCESSORS_ONLN),
+        .period_ms = FLEET_DEFAULT_PERIOD_MS,
+        .duration_s = FLEET_DEFAULT_DURATION_S,
+        .pin = 1,
+    };
+    int robots = 0;
+
+    static struct option long_options[] = {
+        {"robots", required_argument, NULL, 'n'},
+        {"workers", required_argument, NULL, 'w'},
+        {"period", required_argument, NULL, 'p'},
+        {"duration", required_argument, NULL, 'd'},
+        {"no-pin", no_argument, NULL, 'u'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:w:p:d:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'n': robots = atoi(optarg); break;
+            case 'w': config.workers = atoi(optarg); break;
+            case 'p': config.period_ms = atoi(optarg); break;
+            case 'd': config.duration_s = atof(optarg); break;
+            case 'u': config.pin = 0; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default: print_usage(argv[0]); return 1;
+        }
+    }
+    if (config.workers <= 0 || config.period_ms <= 0 || config.duration_s <= 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE* results = fopen("output/fleet_scaling.txt", "w");
+    if (results) fprintf(results, "N\tworkers\tsteps_per_s\texec_mean_ms\texec_max_ms\tutilization\tlat_p50_us\tlat_p99_us\tlat_max_us\tmisses\n");
+
+    printf("--- Simulação de Frota: até %d workers, período %d ms, %.1f s por ponto ---\n",
+           config.workers, config.period_ms, config.duration_s);
+    printf("%8s %7s %14s %10s %10s %7s %10s %10s %10s %7s\n",
+           "N", "workers", "passos/s", "exec(ms)", "pior(ms)", "U(%)", "p50(us)", "p99(us)", "max(us)", "perdas");
+
+    int status = 0;
+    int first = (robots > 0) ? robots : 1;
+    int last = (robots > 0) ? robots : FLEET_MAX_SWEEP;
+    for (int n = first; n <= last; n *= 10) {
+        FleetState* fleet = createFleet(n);
+        FleetReport report;
+        if (fleet == NULL || runFleet(fleet, &config, &report) != 0) {
+            fprintf(stderr, "Erro ao simular a frota com %d robôs\n", n);
+            freeFleet(fleet);
+            status = 1;
+            break;
+        }
+
+        printf("%8d %7d %14.0f %10.3f %10.3f %7.1f %10.1f %10.1f %10.1f %7ld\n",
+               n, report.workers, report.steps_per_s, report.exec_mean_ms, report.exec_max_ms, 100.0 * report.utilization,
+               report.latency_p50_us, report.latency_p99_us, report.latency_max_us, report.misses);
+        if (results) {
+            fprintf(results, "%d\t%d\t%f\t%f\t%f\t%f\t%f\t%f\t%f\t%ld\n",
+                    n, report.workers, report.steps_per_s, report.exec_mean_ms, report.exec_max_ms, report.utilization,
+                    report.latency_p50_us, report.latency_p99_us, report.latency_max_us, report.misses);
+        }
+        freeFleet(fleet);
+    }
+
+    if (results) fclose(results);
+    return status;
+}
@@ -1,78 +1,139 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <math.h>
 #include <stdbool.h>
+#include <getopt.h>
 #include "matrixOperations.h"
+#include "controlTasks.h"
+#include "taskPlacement.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "cyclicSchedule.h"
+#include "rtPolicy.h"
+#include "rtGuard.h"
 #include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
 #include <time.h>
 #include <termios.h> // Para controle do terminal
 #include <fcntl.h>   // Para controle de arquivos
 
-// --- Constantes da Simulação ---
-#define SIMULATION_TIME 20.0
-#define ROBOT_DIAMETER 0.6
-#define R_ROBOT (ROBOT_DIAMETER / 2.0)
-#define PI 3.14159265358979323846
-
-// --- Períodos das Threads (em milissegundos) ---
-#define ROBOT_SIM_PERIOD_MS 30
-#define LINEARIZATION_PERIOD_MS 40
-#define CONTROL_PERIOD_MS 50
-#define REF_MODEL_X_PERIOD_MS 50
-#define REF_MODEL_Y_PERIOD_MS 50
-#define REFERENCE_GEN_PERIOD_MS 120
-#define LOGGER_PERIOD_MS 100
-
-// --- Variáveis Compartilhadas e Mutexes ---
-double current_time = 0.0;
-pthread_mutex_t time_mutex;
-
-// Estado do robô: x_state = [xc, yc, theta]T
-Matrix* x_state;
-pthread_mutex_t x_state_mutex;
-
-// Saída do robô: y_output = [y1, y2]T
-Matrix* y_output;
-pthread_mutex_t y_output_mutex;
-
-// Entrada de controle linearizada: v_input = [v1, v2]T
-Matrix* v_input;
-pthread_mutex_t v_input_mutex;
-
-// Entrada do robô: u_input = [v, w]T
-Matrix* u_input;
-pthread_mutex_t u_input_mutex;
-
-// Saídas do modelo de referência: ym = [ymx, ymy]T
-Matrix* ym_output;
-pthread_mutex_t ym_output_mutex;
-
-// Derivadas do modelo de referência: ym_dot = [ymx_dot, ymy_dot]T
-Matrix* ym_dot_output;
-pthread_mutex_t ym_dot_output_mutex;
-
-// Referência: ref = [xref, yref]T
-Matrix* ref_input;
-pthread_mutex_t ref_input_mutex;
-
-// Parâmetros do controlador
-double alpha1 = 3.0;
-double alpha2 = 3.0;
-pthread_mutex_t alpha_mutex;
-
-// --- Protótipos das Funções das Threads ---
-void* robot_simulation_thread(void* arg);
-void* linearization_thread(void* arg);
-void* control_thread(void* arg);
-void* ref_model_x_thread(void* arg);
-void* ref_model_y_thread(void* arg);
-void* reference_generation_thread(void* arg);
-// void* logger_thread(void* arg);
-void* user_interface_thread(void* arg);
-
-void write_timing_info(FILE* file, struct timespec* last_time) {
+// Capacidade do gravador de sinais (~2,6 MB, folga para uma simulação completa)
+#define TRACE_CAPACITY (1 << 16)
+
+// Nome da thread única do executivo cíclico na especificação de afinidade
+#define CYCLIC_EXECUTIVE_NAME "executivo"
+
+// Carga sintética (--load): fatia de cálculo entre verificações do fim da simulação
+#define LOAD_CHUNK_MS 10
+#define MAX_LOAD_THREADS 64
+
+// --- Escalonamento ---
+#define TASK_STATS_PATH "output/task_stats.txt"   // estatísticas da última execução (WCET medido)
+#define LOCK_STATS_PATH "output/lock_stats.txt"   // uso das travas por tarefa (termos de bloqueio)
+#define DEFAULT_WCET_MS 1.0      // estimativa de C quando não há medição anterior
+#define WCET_MARGIN 2.0          // folga do orçamento reservado sobre o WCET medido
+#define MIN_BUDGET_MS 0.1        // orçamento mínimo (cobre o custo de despertar a thread)
+#define RMS_PRIORITY_MAX 80      // prioridade SCHED_FIFO da tarefa de menor período
+
+// --- Grupos de Tarefas (usados na especificação de afinidade) ---
+#define GROUP_CONTROL "controle"
+#define GROUP_INTERFACE "interface"
+
+// --- Tarefas Periódicas ---
+
+/*
+ * Cada tarefa é descrita por uma entrada da tabela abaixo. A thread genérica
+ * periodic_thread chama init uma vez, step a cada período e finish ao final.
+ */
+typedef struct {
+    const char* name;          // nome usado na especificação de afinidade e nos relatórios
+    const char* group;         // grupo da partição (GROUP_CONTROL ou GROUP_INTERFACE)
+    int period_ms;
+    const char* timing_path;   // arquivo com os períodos medidos T(k)
+    int (*init)(void);         // opcional; retorna 0 em caso de sucesso
+    void (*step)(void);
+    void (*finish)(void);      // opcional
+    pthread_t tid;
+    TaskPlacement placement;
+    TaskStatsCell timing;      // estatísticas escritas só pela própria thread, sob seqlock
+    int priority;              // prioridade RMS (usada em SCHED_FIFO)
+    double wcet_ms;            // WCET medido na execução anterior (ou DEFAULT_WCET_MS)
+    SchedPolicy policy;        // política efetiva, após eventual recuo
+} PeriodicTask;
+
+// --- Protótipos da Interface com o Usuário ---
+int user_interface_init(void);
+void user_interface_step(void);
+void user_interface_finish(void);
+
+void* periodic_thread(void* arg);
+void* cyclic_executive_thread(void* arg);
+void* load_thread(void* arg);
+
+// Ordem de criação das threads (indexada pelos identificadores de controlTasks.h)
+PeriodicTask tasks[] = {
+    [TASK_REF_GEN] = {"ref_gen", GROUP_CONTROL, REFERENCE_GEN_PERIOD_MS, "output/ref_gen_timing.txt", NULL, reference_generation_step, NULL},
+    [TASK_REF_MODEL_X] = {"ref_model_x", GROUP_CONTROL, REF_MODEL_X_PERIOD_MS, "output/ref_model_x_timing.txt", NULL, ref_model_x_step, NULL},
+    [TASK_REF_MODEL_Y] = {"ref_model_y", GROUP_CONTROL, REF_MODEL_Y_PERIOD_MS, "output/ref_model_y_timing.txt", NULL, ref_model_y_step, NULL},
+    [TASK_CONTROL] = {"control", GROUP_CONTROL, CONTROL_PERIOD_MS, "output/control_timing.txt", NULL, control_step, NULL},
+    [TASK_LINEARIZATION] = {"linearization", GROUP_CONTROL, LINEARIZATION_PERIOD_MS, "output/linearization_timing.txt", NULL, linearization_step, NULL},
+    [TASK_ROBOT_SIM] = {"robot_sim", GROUP_CONTROL, ROBOT_SIM_PERIOD_MS, "output/robot_sim_timing.txt", NULL, robot_simulation_step, NULL},
+    [TASK_LOGGER] = {"logger", GROUP_INTERFACE, LOGGER_PERIOD_MS, "output/logger_timing.txt", user_interface_init, user_interface_step, user_interface_finish},
+};
+#define NUM_TASKS ((int)(sizeof(tasks) / sizeof(tasks[0])))
+_Static_assert(NUM_TASKS <= LOCK_MAX_TASKS, "o perfil das travas não comporta todas as tarefas");
+_Static_assert(NUM_TASKS <= RT_GUARD_MAX_TASKS, "a guarda de tempo real não comporta todas as tarefas");
+
+// Chaves aceitas na especificação de afinidade além de "all": tarefas, grupos e o executivo
+const char* placement_keys[NUM_TASKS + 4];
+
+// Segmento de telemetria (NULL quando a interface usa o terminal)
+TelemetrySegment* telemetry = NULL;
+
+// Política pedida na linha de comando (a efetiva de cada tarefa fica em PeriodicTask)
+SchedPolicy requested_policy = POLICY_OTHER;
+int wcet_measured = 0;   // 1 se todos os WCETs vieram da execução anterior
+
+// Acerto da política do conjunto: cada thread informa a política que conseguiu
+// e espera a decisão, que vale para todas (ver settle_set_policy)
+pthread_mutex_t policy_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t policy_cond = PTHREAD_COND_INITIALIZER;
+int policies_reported = 0;
+int policy_settled = 0;
+SchedPolicy set_policy = POLICY_OTHER;
+
+// --- Executivo Cíclico ---
+
+// Ocupação dos quadros (tempo do início do quadro ao fim da última tarefa)
+typedef struct {
+    long frames;
+    long overruns;        // quadros que terminaram depois do início do seguinte
+    double sum_used_ms;
+    double max_used_ms;
+} FrameStats;
+
+CyclicSchedule schedule;
+FrameStats frame_stats;
+
+double elapsed_ms(const struct timespec* from, const struct timespec* to) {
+    return (to->tv_sec - from->tv_sec) * 1000.0 + (to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+void timespec_add_ms(struct timespec* ts, long ms) {
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+double write_timing_info(FILE* file, struct timespec* last_time) {
     struct timespec current_spec;
     clock_gettime(CLOCK_MONOTONIC, &current_spec);
     double delta_s = (current_spec.tv_sec - last_time->tv_sec);
@@ -82,377 +143,791 @@ void write_timing_info(FILE* file, struct timespec* last_time) {
         fprintf(file, "%f\n", period_ms);
     }
     *last_time = current_spec;
+    return period_ms;
 }
 
-// --- Função Principal ---
-int main() {
-    pthread_t tid_robot, tid_linear, tid_control, tid_ref_x, tid_ref_y, tid_ref_gen, tid_logger;
-
-    // Inicialização das variáveis
-    x_state = createMatrix(3, 1); // [xc, yc, theta]
-    y_output = createMatrix(2, 1); // [y1, y2]
-    v_input = createMatrix(2, 1);
-    u_input = createMatrix(2, 1);
-    ym_output = createMatrix(2, 1);
-    ym_dot_output = createMatrix(2, 1);
-    ref_input = createMatrix(2, 1);
-
-    // Inicialização dos Mutexes
-    pthread_mutex_init(&time_mutex, NULL);
-    pthread_mutex_init(&x_state_mutex, NULL);
-    pthread_mutex_init(&y_output_mutex, NULL);
-    pthread_mutex_init(&v_input_mutex, NULL);
-    pthread_mutex_init(&u_input_mutex, NULL);
-    pthread_mutex_init(&ym_output_mutex, NULL);
-    pthread_mutex_init(&ym_dot_output_mutex, NULL);
-    pthread_mutex_init(&ref_input_mutex, NULL);
-    pthread_mutex_init(&alpha_mutex, NULL);
-
-    // Criação das Threads
-    pthread_create(&tid_ref_gen, NULL, reference_generation_thread, NULL);
-    pthread_create(&tid_ref_x, NULL, ref_model_x_thread, NULL);
-    pthread_create(&tid_ref_y, NULL, ref_model_y_thread, NULL);
-    pthread_create(&tid_control, NULL, control_thread, NULL);
-    pthread_create(&tid_linear, NULL, linearization_thread, NULL);
-    pthread_create(&tid_robot, NULL, robot_simulation_thread, NULL);
-    //pthread_create(&tid_logger, NULL, logger_thread, NULL);
-    pthread_create(&tid_logger, NULL, user_interface_thread, NULL);
+void print_usage(const char* program) {
+    printf("Uso: %s [opções]\n", program);
+    printf("  -a, --affinity ESPEC   fixa tarefas em CPUs, ex: \"%s=3;%s=0-1\"\n", GROUP_CONTROL, GROUP_INTERFACE);
+    printf("                         chaves: nome da tarefa, grupo (%s, %s) ou all\n", GROUP_CONTROL, GROUP_INTERFACE);
+    printf("  -t, --telemetry        publica o estado em memória compartilhada (%s) em vez de\n", TELEMETRY_SHM_NAME);
+    printf("                         usar o terminal; acompanhe com ./bin/monitor\n");
+    printf("  -r, --record ARQUIVO   grava todos os sinais publicados em um trace binário\n");
+    printf("                         (reproduzível com ./bin/replay)\n");
+    printf("  -p, --policy NOME      política das tarefas: other (padrão), fifo (prioridades RMS)\n");
+    printf("                         ou deadline (SCHED_DEADLINE/EDF); fifo e deadline usam\n");
+    printf("                         temporização absoluta, mlockall e teste de admissão\n");
+    printf("  -l, --load N           cria N threads de carga (SCHED_OTHER, sem afinidade) que disputam\n");
+    printf("                         a CPU com as tarefas durante toda a simulação\n");
+    printf("  -c, --cyclic           executivo cíclico: todas as tarefas em uma única thread fixada,\n");
+    printf("                         sem travas, seguindo a tabela de quadros do hiperperíodo\n");
+    printf("                         (afinidade pela chave %s, pelo grupo %s ou all)\n", CYCLIC_EXECUTIVE_NAME, GROUP_CONTROL);
+    printf("  -h, --help             mostra esta ajuda\n");
+    printf("Tarefas:");
+    for (int i = 0; i < NUM_TASKS; i++) printf(" %s", tasks[i].name);
+    printf("\n");
+}
 
-    // Aguarda o término das threads
-    pthread_join(tid_logger, NULL);
-    // As outras threads são terminadas quando a simulação acaba
+// Relatório final: afinidade de cada tarefa e migrações entre CPUs observadas.
+void print_placement_report(const int* verified) {
+    printf("\n--- Alocação e Migrações por Tarefa ---\n");
+    printf("%-14s %-10s %-10s %-11s %10s %10s %9s\n",
+           "Tarefa", "Grupo", "CPUs", "Afinidade", "Ativações", "Migrações", "Taxa (%)");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        const TaskPlacement* p = &tasks[i].placement;
+        char cpus[64] = "livre";
+        if (p->pinned) formatCpuList(&p->cpus, cpus, sizeof(cpus));
+        const char* status = !p->pinned ? "-" : (verified[i] ? "verificada" : "DIVERGENTE");
+        double rate = (p->samples > 1) ? 100.0 * p->migrations / (p->samples - 1) : 0.0;
+        printf("%-14s %-10s %-10s %-11s %10ld %10ld %9.1f\n",
+               tasks[i].name, tasks[i].group, cpus, status, p->samples, p->migrations, rate);
+    }
+}
 
-    // Liberação de recursos
-    freeMatrix(x_state);
-    freeMatrix(y_output);
-    freeMatrix(v_input);
-    freeMatrix(u_input);
-    freeMatrix(ym_output);
-    freeMatrix(ym_dot_output);
-    freeMatrix(ref_input);
-    pthread_mutex_destroy(&time_mutex);
-    pthread_mutex_destroy(&x_state_mutex);
-    pthread_mutex_destroy(&y_output_mutex);
-    pthread_mutex_destroy(&v_input_mutex);
-    pthread_mutex_destroy(&u_input_mutex);
-    pthread_mutex_destroy(&ym_output_mutex);
-    pthread_mutex_destroy(&ym_dot_output_mutex);
-    pthread_mutex_destroy(&ref_input_mutex);
-    pthread_mutex_destroy(&alpha_mutex);
+// Relatório final: estatísticas de temporização de cada tarefa.
+void print_timing_report(void) {
+    printf("\n--- Temporização por Tarefa (ms) ---\n");
+    printf("%-14s %7s %10s %10s %10s %10s %10s %8s  %s\n",
+           "Tarefa", "Período", "T médio", "T máximo", "|J| máx", "C médio", "C máximo", "Perdas", "Política");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        const TaskTimingStats* st = &tasks[i].timing.stats;
+        double mean_period = (st->period_samples > 0) ? st->sum_period_ms / st->period_samples : 0.0;
+        double mean_exec = (st->activations > 0) ? st->sum_exec_ms / st->activations : 0.0;
+        printf("%-14s %7d %10.3f %10.3f %10.3f %10.4f %10.4f %8ld  %s\n",
+               tasks[i].name, tasks[i].period_ms, mean_period, st->max_period_ms, st->max_jitter_ms,
+               mean_exec, st->max_exec_ms, st->misses, policyName(tasks[i].policy));
+    }
+}
 
-    printf("Simulação concluída. Execute 'make plot' para ver os resultados.\n");
-    return 0;
+// --- Escalonamento: Prioridades, WCET e Admissão ---
+
+// RMS: quanto menor o período, maior a prioridade (períodos iguais dividem o nível).
+void assign_rms_priorities(void) {
+    for (int i = 0; i < NUM_TASKS; i++) {
+        int shorter = 0;
+        for (int j = 0; j < NUM_TASKS; j++) {
+            int counted = 0;
+            for (int k = 0; k < j; k++) counted |= (tasks[k].period_ms == tasks[j].period_ms);
+            if (!counted && tasks[j].period_ms < tasks[i].period_ms) shorter++;
+        }
+        tasks[i].priority = RMS_PRIORITY_MAX - shorter;
+    }
+}
+
+// Lê o C máximo de cada tarefa gravado pela execução anterior. Retorna quantas foram encontradas.
+int load_measured_wcet(const char* path) {
+    for (int i = 0; i < NUM_TASKS; i++) tasks[i].wcet_ms = DEFAULT_WCET_MS;
+
+    FILE* file = fopen(path, "r");
+    if (!file) return 0;
+
+    int found = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char name[32];
+        double c_max;
+        // tarefa, período, prioridade, política, ativações, perdas, C médio, C máximo, ...
+        if (sscanf(line, "%31s %*d %*d %*s %*d %*d %*f %lf", name, &c_max) != 2) continue;
+        for (int i = 0; i < NUM_TASKS; i++) {
+            if (strcmp(tasks[i].name, name) == 0 && c_max > 0) {
+                tasks[i].wcet_ms = c_max;
+                found++;
+            }
+        }
+    }
+    fclose(file);
+    return found;
 }
 
-// --- Implementação das Threads ---
+// Orçamento C usado na admissão e reservado em SCHED_DEADLINE: WCET com folga, limitado ao período.
+double task_budget_ms(const PeriodicTask* task) {
+    double budget = task->wcet_ms * WCET_MARGIN;
+    if (budget < MIN_BUDGET_MS) budget = MIN_BUDGET_MS;
+    if (budget > task->period_ms) budget = task->period_ms;
+    return budget;
+}
 
-// Executa cálculos intensos pra simular uma carga de trabalho na CPU.
-void simulate_load(long duration_ms) {
-    long iterations = duration_ms * 10000; // Ajuste conforme necessário. Depende do hardware de quem está executando
-    double result = 0.0;
-    for (long i = 0; i < iterations; i++) {
-        result += sin(i) * tan(i);
+// Imprime e aplica o teste de admissão da política pedida. Retorna 1 se o conjunto foi admitido.
+int run_admission_test(SchedPolicy policy, int measured) {
+    double budgets[NUM_TASKS];
+    int periods[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) {
+        budgets[i] = task_budget_ms(&tasks[i]);
+        periods[i] = tasks[i].period_ms;
+    }
+    AdmissionResult result;
+    admissionTest(policy, budgets, periods, NUM_TASKS, &result);
+
+    printf("--- Teste de Admissão (%s) ---\n", policyName(policy));
+    printf("WCET: %s\n", measured ? "medido na execução anterior (" TASK_STATS_PATH ")" : "estimativa padrão (sem medição anterior)");
+    printf("%-14s %7s %10s %10s %8s %9s\n", "Tarefa", "T (ms)", "WCET (ms)", "C (ms)", "U", "Prior.");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        printf("%-14s %7d %10.4f %10.4f %8.4f %9d\n", tasks[i].name, periods[i], tasks[i].wcet_ms,
+               budgets[i], budgets[i] / periods[i], tasks[i].priority);
     }
+    printf("U total = %.4f | limite %s = %.4f -> %s\n", result.utilization,
+           policy == POLICY_FIFO ? "RMS" : "EDF", result.bound, result.admitted ? "admitido" : "RECUSADO");
+    // Escalando todos os períodos por s, U vira U/s: o menor s admissível é U/limite
+    printf("Menor escala uniforme dos períodos que ainda passa no teste: %.4f\n\n", result.utilization / result.bound);
+    return result.admitted;
 }
 
-void* reference_generation_thread(void* arg) {
-    FILE* timing_file = fopen("output/ref_gen_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing da geração de referência");
-        return NULL;
+// Grava as estatísticas desta execução; o C máximo vira o WCET da próxima admissão.
+void write_task_stats(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        perror("Erro ao gravar as estatísticas das tarefas");
+        return;
     }
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
+    fprintf(file, "tarefa\tperiodo_ms\tprioridade\tpolitica\tativacoes\tperdas\tc_medio_ms\tc_max_ms\tj_max_ms\tlatencia_max_ms\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        const TaskTimingStats* st = &tasks[i].timing.stats;
+        double mean_exec = (st->activations > 0) ? st->sum_exec_ms / st->activations : 0.0;
+        fprintf(file, "%s\t%d\t%d\t%s\t%ld\t%ld\t%.6f\t%.6f\t%.6f\t%.6f\n", tasks[i].name, tasks[i].period_ms,
+                tasks[i].priority, policyName(tasks[i].policy), st->activations, st->misses, mean_exec,
+                st->max_exec_ms, st->max_jitter_ms, st->max_latency_ms);
+    }
+    fclose(file);
+}
 
-    fprintf(timing_file, "T(k)\n");
+// --- Contenção nas Travas ---
 
-    while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&time_mutex);
-        double t = current_time;
-        pthread_mutex_unlock(&time_mutex);
-        
-        double xref_val = (5.0 / PI) * cos(0.2 * PI * t);
-        double yref_val = (t < 10.0) ? (5.0 / PI) * sin(0.2 * PI * t) : -(5.0 / PI) * sin(0.2 * PI * t);
+// Quantil do histograma em us, limitado ao máximo observado (o balde só dá o limite superior).
+double lock_quantile_us(const uint64_t* hist, double q, uint64_t max_ns) {
+    uint64_t ns = lockHistogramQuantile(hist, q);
+    return ((ns < max_ns) ? ns : max_ns) / 1e3;
+}
 
-        pthread_mutex_lock(&ref_input_mutex);
-        ref_input->data[0][0] = xref_val;
-        ref_input->data[1][0] = yref_val;
-        pthread_mutex_unlock(&ref_input_mutex);
+// Relatório final: perfil de cada trava e, por tarefa, as travas em que ela esperou.
+void print_lock_report(void) {
+    printf("\n--- Travas (herança de prioridade; tempos em us) ---\n");
+    printf("%-14s %10s %10s %9s %9s %9s %9s %9s %9s\n",
+           "Trava", "Aquisições", "Contenção", "Esp. p50", "Esp. p99", "Esp. máx", "Posse p50", "Posse p99", "Posse máx");
+    for (int l = 0; l < NUM_SHARED_LOCKS; l++) {
+        const ProfiledMutex* m = shared_locks[l];
+        double contention = (m->acquisitions > 0) ? 100.0 * m->contended / m->acquisitions : 0.0;
+        printf("%-14s %10ld %9.2f%% %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", m->name, m->acquisitions, contention,
+               lock_quantile_us(m->wait_hist, 0.5, m->max_wait_ns), lock_quantile_us(m->wait_hist, 0.99, m->max_wait_ns),
+               m->max_wait_ns / 1e3, lock_quantile_us(m->hold_hist, 0.5, m->max_hold_ns),
+               lock_quantile_us(m->hold_hist, 0.99, m->max_hold_ns), m->max_hold_ns / 1e3);
+    }
+
+    printf("\nTravas que acrescentam latência a cada tarefa (espera total, em ordem decrescente):\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        int order[NUM_SHARED_LOCKS];
+        int count = 0;
+        for (int l = 0; l < NUM_SHARED_LOCKS; l++) {
+            if (shared_locks[l]->tasks[i].contended == 0) continue;
+            int k = count++;
+            while (k > 0 && shared_locks[order[k - 1]]->tasks[i].sum_wait_ns < shared_locks[l]->tasks[i].sum_wait_ns) {
+                order[k] = order[k - 1];
+                k--;
+            }
+            order[k] = l;
+        }
 
-        usleep(REFERENCE_GEN_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+        printf("  %-14s", tasks[i].name);
+        if (count == 0) printf(" nenhuma espera");
+        for (int k = 0; k < count; k++) {
+            const ProfiledMutex* m = shared_locks[order[k]];
+            const LockTaskStats* st = &m->tasks[i];
+            printf(" %s (%ldx, total %.1f us, máx %.1f us)%s", m->name, st->contended, st->sum_wait_ns / 1e3,
+                   st->max_wait_ns / 1e3, (k + 1 < count) ? ";" : "");
+        }
+        printf("\n");
     }
-    fclose(timing_file);
-    return NULL;
 }
 
-void* ref_model_x_thread(void* arg) {
-    FILE* timing_file = fopen("output/ref_model_x_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing do modelo de referência X");
-        return NULL;
+// --- Guarda da Fase de Tempo Real ---
+
+// Relatório final: alocações, faltas de página e bloqueios dentro das ativações de cada tarefa.
+// Retorna quantas tarefas violaram a fase de tempo real (alocação ou falta de página).
+int print_guard_report(RtGuardMode mode) {
+    if (mode == RT_GUARD_OFF) return 0;
+
+    printf("\n--- Guarda da Fase de Tempo Real (modo %s) ---\n", rtGuardModeName(mode));
+    printf("%-14s %10s %8s %8s %8s %8s %10s %10s %11s  %s\n", "Tarefa", "Ativações", "Alocs.", "Frees",
+           "Faltas", "Faltas M", "Ativ. c/F", "Bloqueios", "Preempções", "Situação");
+    int violating = 0;
+    for (int i = 0; i < NUM_TASKS; i++) {
+        const RtGuardTaskStats* st = rtGuardStats(i);
+        int violation = (st->allocations + st->frees + st->minor_faults + st->major_faults) > 0;
+        violating += violation;
+        printf("%-14s %10ld %8ld %8ld %8ld %8ld %10ld %10ld %11ld  %s\n", tasks[i].name, st->activations,
+               st->allocations, st->frees, st->minor_faults, st->major_faults, st->faulting_activations,
+               st->voluntary_switches, st->involuntary_switches, violation ? "VIOLAÇÃO" : "ok");
     }
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
+    if (violating > 0) {
+        printf("%d tarefa(s) alocaram memória ou sofreram faltas de página dentro das ativações", violating);
+        printf("%s\n", requested_policy == POLICY_OTHER ? " (sem mlockall em --policy other)" : "");
+    }
+    return violating;
+}
 
-    double ymx = 0.0;
-    double dt = REF_MODEL_X_PERIOD_MS / 1000.0;
+// Grava o uso de cada trava por tarefa (entrada dos termos de bloqueio da análise de tempo de resposta).
+void write_lock_stats(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        perror("Erro ao gravar as estatísticas das travas");
+        return;
+    }
+    fprintf(file, "trava\ttarefa\taquisicoes\tcontencoes\tespera_total_ms\tespera_max_ms\tposse_max_ms\n");
+    for (int l = 0; l < NUM_SHARED_LOCKS; l++) {
+        const ProfiledMutex* m = shared_locks[l];
+        for (int i = 0; i < NUM_TASKS; i++) {
+            const LockTaskStats* st = &m->tasks[i];
+            if (st->acquisitions == 0) continue;
+            fprintf(file, "%s\t%s\t%ld\t%ld\t%.6f\t%.6f\t%.6f\n", m->name, tasks[i].name, st->acquisitions,
+                    st->contended, st->sum_wait_ns / 1e6, st->max_wait_ns / 1e6, st->max_hold_ns / 1e6);
+        }
+    }
+    fclose(file);
+}
 
-    fprintf(timing_file, "T(k)\n");
+// Relatório final do executivo cíclico: tabela de quadros e estouros.
+void print_frame_report(void) {
+    const char* names[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) names[i] = tasks[i].name;
 
-    while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&ref_input_mutex);
-        double xref = ref_input->data[0][0];
-        pthread_mutex_unlock(&ref_input_mutex);
+    printf("\n--- Executivo Cíclico ---\n");
+    printCyclicSchedule(&schedule, names);
+    double mean_used = (frame_stats.frames > 0) ? frame_stats.sum_used_ms / frame_stats.frames : 0.0;
+    printf("Quadros executados: %ld | Estouros: %ld | Ocupação média: %.4f ms | máxima: %.4f ms (quadro de %d ms)\n",
+           frame_stats.frames, frame_stats.overruns, mean_used, frame_stats.max_used_ms, schedule.minor_ms);
+}
 
-        pthread_mutex_lock(&alpha_mutex);
-        double a1 = alpha1;
-        pthread_mutex_unlock(&alpha_mutex);
+// Relatório final: CPU consumida e trocas de contexto do processo inteiro.
+void print_resource_report(double wall_s) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double user_s = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+    double system_s = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+
+    printf("\n--- Uso de Recursos do Processo ---\n");
+    printf("Tempo de parede: %.2f s | CPU: %.3f s (usuário %.3f + sistema %.3f) = %.2f%%\n",
+           wall_s, user_s + system_s, user_s, system_s, 100.0 * (user_s + system_s) / wall_s);
+    printf("Trocas de contexto: %ld voluntárias, %ld involuntárias\n", usage.ru_nvcsw, usage.ru_nivcsw);
+}
 
-        double ymx_dot = a1 * (xref - ymx);
-        ymx += ymx_dot * dt;
+// Informa a política efetiva da thread e espera a política decidida para o conjunto.
+SchedPolicy report_task_policy(void) {
+    pthread_mutex_lock(&policy_mutex);
+    policies_reported++;
+    pthread_cond_broadcast(&policy_cond);
+    while (!policy_settled) pthread_cond_wait(&policy_cond, &policy_mutex);
+    SchedPolicy policy = set_policy;
+    pthread_mutex_unlock(&policy_mutex);
+    return policy;
+}
 
-        pthread_mutex_lock(&ym_output_mutex);
-        ym_output->data[0][0] = ymx;
-        pthread_mutex_unlock(&ym_output_mutex);
-        
-        pthread_mutex_lock(&ym_dot_output_mutex);
-        ym_dot_output->data[0][0] = ymx_dot;
-        pthread_mutex_unlock(&ym_dot_output_mutex);
+/*
+ * Espera as `created` threads informarem a política efetiva e decide a do
+ * conjunto: se alguma tarefa recuou, todas recuam para a mais fraca, e a
+ * admissão é refeita para ela (ex.: deadline -> fifo passa a exigir o limite
+ * RMS). Se o conjunto não passar, todas ficam em other.
+ */
+void settle_set_policy(int created) {
+    pthread_mutex_lock(&policy_mutex);
+    while (policies_reported < created) pthread_cond_wait(&policy_cond, &policy_mutex);
+
+    SchedPolicy policy = requested_policy;
+    for (int i = 0; i < created; i++) {
+        if (tasks[i].policy < policy) policy = tasks[i].policy;
+    }
+    if (policy != requested_policy && policy != POLICY_OTHER) {
+        fprintf(stderr, "Aviso: o conjunto recuou para %s; refazendo a admissão\n", policyName(policy));
+        if (!run_admission_test(policy, wcet_measured)) {
+            fprintf(stderr, "Aviso: conjunto recusado em %s; usando %s\n", policyName(policy), policyName(POLICY_OTHER));
+            policy = POLICY_OTHER;
+        }
+    }
 
-        usleep(REF_MODEL_X_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+    set_policy = policy;
+    policy_settled = 1;
+    pthread_cond_broadcast(&policy_cond);
+    pthread_mutex_unlock(&policy_mutex);
+}
+
+// Cria uma thread por tarefa e aguarda o término. Retorna 0 se todas foram criadas.
+int run_periodic_threads(int* verified) {
+    int created = 0;
+    for (int i = 0; i < NUM_TASKS; i++) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        int err = applyPlacementAttr(&attr, &tasks[i].placement);
+        if (err == 0) err = pthread_create(&tasks[i].tid, &attr, periodic_thread, &tasks[i]);
+        pthread_attr_destroy(&attr);
+        if (err != 0) {
+            fprintf(stderr, "Erro ao criar a thread %s: %s\n", tasks[i].name, strerror(err));
+            current_time = SIMULATION_TIME; // encerra as threads já criadas
+            break;
+        }
+        verified[i] = (verifyPlacement(tasks[i].tid, &tasks[i].placement) == 0);
+        if (!verified[i]) {
+            fprintf(stderr, "Aviso: afinidade efetiva de %s difere da configurada\n", tasks[i].name);
+        }
+        created++;
     }
-    fclose(timing_file);
-    return NULL;
+    settle_set_policy(created);
+
+    // Aguarda o término das threads
+    for (int i = 0; i < created; i++) {
+        pthread_join(tasks[i].tid, NULL);
+    }
+    return (created == NUM_TASKS) ? 0 : -1;
 }
 
-void* ref_model_y_thread(void* arg) {
-    FILE* timing_file = fopen("output/ref_model_y_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing do modelo de referência Y");
-        return NULL;
+// Roda todas as tarefas em uma única thread fixada. Retorna 0 em caso de sucesso.
+int run_cyclic_executive(const char* affinity_spec, int* verified) {
+    int periods[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) periods[i] = tasks[i].period_ms;
+    if (buildCyclicSchedule(periods, NUM_TASKS, &schedule) != 0) {
+        fprintf(stderr, "Não foi possível gerar a tabela de quadros para os períodos configurados\n");
+        return -1;
     }
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
-    
-    fprintf(timing_file, "T(k)\n");
 
-    double ymy = 0.0;
-    double dt = REF_MODEL_Y_PERIOD_MS / 1000.0;
+    // Sem afinidade configurada, a thread fica na CPU em que o processo está
+    TaskPlacement placement;
+    resolvePlacement(affinity_spec, CYCLIC_EXECUTIVE_NAME, GROUP_CONTROL, placement_keys, &placement);
+    if (!placement.pinned) {
+        CPU_ZERO(&placement.cpus);
+        CPU_SET(sched_getcpu(), &placement.cpus);
+        placement.pinned = 1;
+    }
 
-    while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&ref_input_mutex);
-        double yref = ref_input->data[1][0];
-        pthread_mutex_unlock(&ref_input_mutex);
+    // Uma única thread acessa o estado compartilhado: as travas são dispensáveis
+    shared_locking = 0;
+
+    pthread_t tid;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    int err = applyPlacementAttr(&attr, &placement);
+    if (err == 0) err = pthread_create(&tid, &attr, cyclic_executive_thread, NULL);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        fprintf(stderr, "Erro ao criar a thread do executivo cíclico: %s\n", strerror(err));
+        return -1;
+    }
+
+    // Todas as tarefas compartilham a afinidade (e as migrações) da thread única
+    int ok = (verifyPlacement(tid, &placement) == 0);
+    if (!ok) fprintf(stderr, "Aviso: afinidade efetiva do executivo cíclico difere da configurada\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        tasks[i].placement = placement;
+        verified[i] = ok;
+    }
+
+    pthread_join(tid, NULL);
+    return 0;
+}
 
-        pthread_mutex_lock(&alpha_mutex);
-        double a2 = alpha2;
-        pthread_mutex_unlock(&alpha_mutex);
+// --- Função Principal ---
+int main(int argc, char* argv[]) {
+    const char* affinity_spec = NULL;
+
+    static struct option long_options[] = {
+        {"affinity", required_argument, NULL, 'a'},
+        {"telemetry", no_argument, NULL, 't'},
+        {"record", required_argument, NULL, 'r'},
+        {"policy", required_argument, NULL, 'p'},
+        {"cyclic", no_argument, NULL, 'c'},
+        {"load", required_argument, NULL, 'l'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+    int use_telemetry = 0;
+    const char* record_path = NULL;
+    int cyclic = 0;
+    int load_threads = 0;
+    while ((opt = getopt_long(argc, argv, "a:tr:p:cl:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'a': affinity_spec = optarg; break;
+            case 't': use_telemetry = 1; break;
+            case 'r': record_path = optarg; break;
+            case 'p':
+                if (parsePolicy(optarg, &requested_policy) != 0) {
+                    fprintf(stderr, "Política desconhecida: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'c': cyclic = 1; break;
+            case 'l':
+                load_threads = atoi(optarg);
+                if (load_threads < 0 || load_threads > MAX_LOAD_THREADS) {
+                    fprintf(stderr, "Número de threads de carga inválido: %s (0 a %d)\n", optarg, MAX_LOAD_THREADS);
+                    return 1;
+                }
+                break;
+            case 'h': print_usage(argv[0]); return 0;
+            default: print_usage(argv[0]); return 1;
+        }
+    }
+
+    int num_keys = 0;
+    for (int i = 0; i < NUM_TASKS; i++) placement_keys[num_keys++] = tasks[i].name;
+    placement_keys[num_keys++] = GROUP_CONTROL;
+    placement_keys[num_keys++] = GROUP_INTERFACE;
+    placement_keys[num_keys++] = CYCLIC_EXECUTIVE_NAME;
+    placement_keys[num_keys] = NULL;
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (resolvePlacement(affinity_spec, tasks[i].name, tasks[i].group, placement_keys, &tasks[i].placement) != 0) {
+            fprintf(stderr, "Especificação de afinidade inválida: %s\n", affinity_spec);
+            return 1;
+        }
+        strncpy(tasks[i].timing.stats.name, tasks[i].name, TELEMETRY_NAME_LEN - 1);
+        tasks[i].timing.stats.period_ms = tasks[i].period_ms;
+    }
+
+    // Guarda da fase de tempo real: modo lido de RT_GUARD (count, trap ou off)
+    const char* task_names[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) task_names[i] = tasks[i].name;
+    RtGuardMode guard_mode = rtGuardInit(task_names, NUM_TASKS);
+
+    // Escalonamento: prioridades RMS, WCET da execução anterior e admissão
+    assign_rms_priorities();
+    wcet_measured = (load_measured_wcet(TASK_STATS_PATH) == NUM_TASKS);
+    if (cyclic && requested_policy == POLICY_DEADLINE) {
+        fprintf(stderr, "O executivo cíclico não usa SCHED_DEADLINE; use --policy other ou fifo\n");
+        return 1;
+    }
+    if (!cyclic && requested_policy != POLICY_OTHER && !run_admission_test(requested_policy, wcet_measured)) {
+        fprintf(stderr, "Conjunto de tarefas recusado pelo teste de admissão\n");
+        return 1;
+    }
+    if (requested_policy != POLICY_OTHER && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        perror("Aviso: mlockall falhou (páginas podem sofrer page faults)");
+    }
 
-        double ymy_dot = a2 * (yref - ymy);
-        ymy += ymy_dot * dt;
+    if (use_telemetry) {
+        telemetry = telemetryCreate();
+        if (telemetry == NULL) {
+            perror("Erro ao criar o segmento de telemetria");
+            return 1;
+        }
+        printf("Telemetria em %s. Acompanhe com ./bin/monitor\n", TELEMETRY_SHM_NAME);
+    }
 
-        pthread_mutex_lock(&ym_output_mutex);
-        ym_output->data[1][0] = ymy;
-        pthread_mutex_unlock(&ym_output_mutex);
+    if (init_shared_state() != 0) {
+        telemetryDestroy(telemetry);
+        return 1;
+    }
 
-        pthread_mutex_lock(&ym_dot_output_mutex);
-        ym_dot_output->data[1][0] = ymy_dot;
-        pthread_mutex_unlock(&ym_dot_output_mutex);
+    if (record_path) {
+        recorder = createTraceRecorder(TRACE_CAPACITY);
+        if (recorder == NULL) {
+            fprintf(stderr, "Erro ao alocar o buffer de gravação\n");
+            free_shared_state();
+            telemetryDestroy(telemetry);
+            return 1;
+        }
+        double alphas[2] = {alpha1, alpha2};
+        record_signal(TRACE_SIG_ALPHA, TASK_LOGGER, alphas, 2);
+    }
 
-        usleep(REF_MODEL_Y_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+    // Execução: uma thread por tarefa (com afinidade, quando configurada) ou executivo cíclico
+    int verified[NUM_TASKS];
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    pthread_t loaders[MAX_LOAD_THREADS];
+    int started_loaders = 0;
+    for (; started_loaders < load_threads; started_loaders++) {
+        if (pthread_create(&loaders[started_loaders], NULL, load_thread, NULL) != 0) {
+            fprintf(stderr, "Aviso: só %d de %d threads de carga foram criadas\n", started_loaders, load_threads);
+            break;
+        }
     }
-    fclose(timing_file);
-    return NULL;
+    int status = cyclic ? run_cyclic_executive(affinity_spec, verified) : run_periodic_threads(verified);
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    if (status != 0) current_time = SIMULATION_TIME; // encerra as threads de carga
+    for (int i = 0; i < started_loaders; i++) pthread_join(loaders[i], NULL);
+
+    // Liberação de recursos
+    free_shared_state();
+    if (recorder) {
+        if (saveTrace(recorder, record_path) != 0) perror("Erro ao gravar o trace");
+        else printf("Trace gravado em %s\n", record_path);
+        freeTraceRecorder(recorder);
+        recorder = NULL;
+    }
+    telemetryDestroy(telemetry);
+
+    if (status != 0) return 1;
+
+    write_task_stats(TASK_STATS_PATH);
+    write_lock_stats(LOCK_STATS_PATH);
+    print_timing_report();
+    if (cyclic) print_frame_report();
+    else print_lock_report();
+    print_guard_report(guard_mode);
+    print_placement_report(verified);
+    print_resource_report(elapsed_ms(&wall_start, &wall_end) / 1000.0);
+    printf("Simulação concluída. Execute 'make plot' para ver os resultados.\n");
+    return 0;
 }
 
-void* control_thread(void* arg) {
-    FILE* timing_file = fopen("output/control_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing do controle");
+// --- Laço Periódico Genérico ---
+
+void* periodic_thread(void* arg) {
+    PeriodicTask* task = (PeriodicTask*)arg;
+
+    // Mesmo sem conseguir iniciar, a thread informa a política para não travar o acerto do conjunto
+    FILE* timing_file = fopen(task->timing_path, "w");
+    int ready = (timing_file != NULL);
+    if (!ready) fprintf(stderr, "Erro ao abrir o arquivo de timing de %s: %s\n", task->name, strerror(errno));
+    else if (task->init && task->init() != 0) ready = 0;
+
+    task->policy = ready ? applySchedPolicyWithFallback(task->name, requested_policy, task->priority,
+                                                        task_budget_ms(task), task->period_ms)
+                         : requested_policy;
+    SchedPolicy policy = report_task_policy();
+    if (!ready) {
+        if (timing_file) fclose(timing_file);
         return NULL;
     }
-    struct timespec last_time;
+    if (task->policy != policy) {
+        task->policy = applySchedPolicyWithFallback(task->name, policy, task->priority, task_budget_ms(task),
+                                                    task->period_ms);
+    }
+    profiledMutexSetTask((int)(task - tasks));
+    rtGuardEnter((int)(task - tasks));
+
+    struct timespec last_time, release;
     clock_gettime(CLOCK_MONOTONIC, &last_time);
+    release = last_time;
 
     fprintf(timing_file, "T(k)\n");
 
     while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&y_output_mutex);
-        double y1 = y_output->data[0][0];
-        double y2 = y_output->data[1][0];
-        pthread_mutex_unlock(&y_output_mutex);
-
-        pthread_mutex_lock(&ym_output_mutex);
-        double ymx = ym_output->data[0][0];
-        double ymy = ym_output->data[1][0];
-        pthread_mutex_unlock(&ym_output_mutex);
-
-        pthread_mutex_lock(&ym_dot_output_mutex);
-        double ymx_dot = ym_dot_output->data[0][0];
-        double ymy_dot = ym_dot_output->data[1][0];
-        pthread_mutex_unlock(&ym_dot_output_mutex);
-        
-        pthread_mutex_lock(&alpha_mutex);
-        double a1 = alpha1;
-        double a2 = alpha2;
-        pthread_mutex_unlock(&alpha_mutex);
-
-        double v1 = ymx_dot + a1 * (ymx - y1);
-        double v2 = ymy_dot + a2 * (ymy - y2);
-
-        pthread_mutex_lock(&v_input_mutex);
-        v_input->data[0][0] = v1;
-        v_input->data[1][0] = v2;
-        pthread_mutex_unlock(&v_input_mutex);
-
-        usleep(CONTROL_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+        struct timespec start, end;
+        rtGuardStepBegin((int)(task - tasks));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        record_signal(TRACE_SIG_ACTIVATION, (int)(task - tasks), NULL, 0);
+        task->step();
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        rtGuardStepEnd();
+        samplePlacement(&task->placement);
+
+        // Perda de deadline: a ativação terminou depois de liberação + período
+        double latency_ms = elapsed_ms(&release, &start);
+        double exec_ms = elapsed_ms(&start, &end);
+        int missed = elapsed_ms(&release, &end) > task->period_ms;
+
+        if (requested_policy == POLICY_OTHER) {
+            // Temporização relativa: a próxima liberação é um período após o fim desta ativação
+            release = end;
+            timespec_add_ms(&release, task->period_ms);
+            usleep(task->period_ms * 1000);
+        } else {
+            // Temporização absoluta: liberações em múltiplos exatos do período, sem deriva
+            timespec_add_ms(&release, task->period_ms);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &release, NULL);
+        }
+        double period_ms = write_timing_info(timing_file, &last_time);
+        telemetryRecordActivation(&task->timing, period_ms, exec_ms, latency_ms, missed);
     }
+    rtGuardLeave();
+
+    if (task->finish) task->finish();
     fclose(timing_file);
     return NULL;
 }
 
-void* linearization_thread(void* arg) {
-    FILE* timing_file = fopen("output/linearization_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing da linearização");
-        return NULL;
+// --- Laço do Executivo Cíclico ---
+
+/*
+ * A cada quadro menor, executa em sequência (na ordem da tabela, que é a ordem
+ * do fluxo de dados) as tarefas liberadas naquele quadro e dorme até o início
+ * absoluto do próximo. Um quadro que termina depois do início do seguinte é
+ * contado como estouro; o próximo quadro começa atrasado, sem ser descartado.
+ */
+void* cyclic_executive_thread(void* arg) {
+    (void)arg;
+    SchedPolicy policy = applySchedPolicyWithFallback(CYCLIC_EXECUTIVE_NAME, requested_policy, RMS_PRIORITY_MAX, 0.0,
+                                                      schedule.minor_ms);
+    for (int i = 0; i < NUM_TASKS; i++) tasks[i].policy = policy;
+    FILE* timing_files[NUM_TASKS] = {NULL};
+    int initialized = 0;
+    int ready = 1;
+
+    for (int i = 0; i < NUM_TASKS && ready; i++) {
+        timing_files[i] = fopen(tasks[i].timing_path, "w");
+        if (!timing_files[i]) {
+            fprintf(stderr, "Erro ao abrir o arquivo de timing de %s: %s\n", tasks[i].name, strerror(errno));
+            ready = 0;
+            break;
+        }
+        fprintf(timing_files[i], "T(k)\n");
+        if (tasks[i].init && tasks[i].init() != 0) ready = 0;
+        else initialized++;
     }
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
-
-    fprintf(timing_file, "T(k)\n");
 
-    while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&x_state_mutex);
-        double theta = x_state->data[2][0];
-        pthread_mutex_unlock(&x_state_mutex);
-        
-        pthread_mutex_lock(&v_input_mutex);
-        Matrix* v = createMatrix(2, 1);
-        v->data[0][0] = v_input->data[0][0];
-        v->data[1][0] = v_input->data[1][0];
-        pthread_mutex_unlock(&v_input_mutex);
-        
-        Matrix* L = createMatrix(2, 2);
-        L->data[0][0] = cos(theta);
-        L->data[0][1] = -R_ROBOT * sin(theta);
-        L->data[1][0] = sin(theta);
-        L->data[1][1] = R_ROBOT * cos(theta);
-
-        Matrix* L_inv = inverseMatrix(L);
-        if (L_inv) {
-            Matrix* u = multiplyMatrix(L_inv, v);
-            
-            pthread_mutex_lock(&u_input_mutex);
-            u_input->data[0][0] = u->data[0][0];
-            u_input->data[1][0] = u->data[1][0];
-            pthread_mutex_unlock(&u_input_mutex);
-
-            freeMatrix(u);
-            freeMatrix(L_inv);
+    struct timespec frame_release;
+    struct timespec last_start[NUM_TASKS];
+    int activated[NUM_TASKS] = {0};
+    clock_gettime(CLOCK_MONOTONIC, &frame_release);
+    rtGuardEnter(0);
+
+    for (long frame = 0; ready && current_time < SIMULATION_TIME; frame++) {
+        int f = (int)(frame % schedule.num_frames);
+
+        for (int k = 0; k < schedule.frame_count[f]; k++) {
+            int i = schedule.frame_tasks[f][k];
+            PeriodicTask* task = &tasks[i];
+
+            struct timespec start, end;
+            rtGuardStepBegin(i);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            profiledMutexSetTask(i);
+            record_signal(TRACE_SIG_ACTIVATION, i, NULL, 0);
+            task->step();
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            rtGuardStepEnd();
+            samplePlacement(&task->placement);
+
+            // T(k) entre inícios de ativações consecutivas da tarefa
+            double period_ms = 0.0;
+            if (activated[i]) {
+                period_ms = elapsed_ms(&last_start[i], &start);
+                fprintf(timing_files[i], "%f\n", period_ms);
+            }
+            activated[i] = 1;
+            last_start[i] = start;
+
+            // A liberação da tarefa é o início do quadro
+            double latency_ms = elapsed_ms(&frame_release, &start);
+            double exec_ms = elapsed_ms(&start, &end);
+            int missed = elapsed_ms(&frame_release, &end) > task->period_ms;
+            telemetryRecordActivation(&task->timing, period_ms, exec_ms, latency_ms, missed);
         }
-        
-        freeMatrix(L);
-        freeMatrix(v);
 
-        usleep(LINEARIZATION_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+        struct timespec frame_end;
+        clock_gettime(CLOCK_MONOTONIC, &frame_end);
+        double used_ms = elapsed_ms(&frame_release, &frame_end);
+        frame_stats.frames++;
+        frame_stats.sum_used_ms += used_ms;
+        if (used_ms > frame_stats.max_used_ms) frame_stats.max_used_ms = used_ms;
+        if (used_ms > schedule.minor_ms) frame_stats.overruns++;
+
+        timespec_add_ms(&frame_release, schedule.minor_ms);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &frame_release, NULL);
+    }
+    rtGuardLeave();
+
+    for (int i = 0; i < initialized; i++) {
+        if (tasks[i].finish) tasks[i].finish();
+    }
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (timing_files[i]) fclose(timing_files[i]);
     }
-    fclose(timing_file);
     return NULL;
 }
 
-void* robot_simulation_thread(void* arg) {
-    FILE* timing_file = fopen("output/robot_sim_timing.txt", "w");
-    if (!timing_file) {
-        perror("Erro ao abrir o arquivo de timing do robô");
-        return NULL;
-    }
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
-    
-    double dt = ROBOT_SIM_PERIOD_MS / 1000.0;
+// --- Carga Sintética ---
 
-    fprintf(timing_file, "T(k)\n");
+// Destino do resultado da carga (volatile: impede que o compilador descarte o laço)
+volatile double load_sink;
 
-    while (current_time < SIMULATION_TIME) {
-        pthread_mutex_lock(&u_input_mutex);
-        Matrix* u = createMatrix(2, 1);
-        u->data[0][0] = u_input->data[0][0]; // v
-        u->data[1][0] = u_input->data[1][0]; // w
-        pthread_mutex_unlock(&u_input_mutex);
-
-        pthread_mutex_lock(&x_state_mutex);
-        double theta = x_state->data[2][0];
-        
-        Matrix* x_dot_calc = createMatrix(3, 2);
-        x_dot_calc->data[0][0] = cos(theta);
-        x_dot_calc->data[1][0] = sin(theta);
-        x_dot_calc->data[2][1] = 1.0;
-        
-        Matrix* u_vec_for_x_dot = createMatrix(2,1);
-        u_vec_for_x_dot->data[0][0] = u->data[0][0];
-        u_vec_for_x_dot->data[1][0] = u->data[1][0];
-        
-        Matrix* x_dot = multiplyMatrix(x_dot_calc, u_vec_for_x_dot);
-        Matrix* term = scalarMultiply(x_dot, dt);
-        Matrix* x_next = addMatrix(x_state, term);
-        
-        // Atualiza o estado
-        freeMatrix(x_state);
-        x_state = x_next;
-        
-        // Calcula a nova saída y
-        double new_xc = x_state->data[0][0];
-        double new_yc = x_state->data[1][0];
-        double new_theta = x_state->data[2][0];
-        pthread_mutex_unlock(&x_state_mutex);
-
-        pthread_mutex_lock(&y_output_mutex);
-        y_output->data[0][0] = new_xc + R_ROBOT * cos(new_theta);
-        y_output->data[1][0] = new_yc + R_ROBOT * sin(new_theta);
-        pthread_mutex_unlock(&y_output_mutex);
-
-        freeMatrix(u);
-        freeMatrix(u_vec_for_x_dot);
-        freeMatrix(x_dot_calc);
-        freeMatrix(x_dot);
-        freeMatrix(term);
-        
-        pthread_mutex_lock(&time_mutex);
-        current_time += dt;
-        pthread_mutex_unlock(&time_mutex);
-
-        usleep(ROBOT_SIM_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+// Executa cálculos intensos pra simular uma carga de trabalho na CPU.
+void simulate_load(long duration_ms) {
+    long iterations = duration_ms * 10000; // Ajuste conforme necessário. Depende do hardware de quem está executando
+    double result = 0.0;
+    for (long i = 0; i < iterations; i++) {
+        result += sin(i) * tan(i);
     }
-    fclose(timing_file);
+    load_sink = result;
+}
+
+// Thread de carga (SCHED_OTHER, sem afinidade): disputa a CPU com as tarefas até o fim da simulação.
+void* load_thread(void* arg) {
+    (void)arg;
+    // Leitura volatile: sin e tan não tocam a memória e o compilador poderia tirar a leitura do laço
+    while (*(volatile double*)&current_time < SIMULATION_TIME) simulate_load(LOAD_CHUNK_MS);
     return NULL;
 }
 
-void* user_interface_thread(void* arg) {
-    FILE* output_file = fopen("output/simulation_output.txt", "w");
+// --- Interface com o Usuário ---
+static FILE* output_file;
+static struct termios oldt;
+static int oldf;
+
+// Lê o estado compartilhado e as estatísticas das tarefas para a telemetria.
+// As estatísticas vêm do seqlock de cada tarefa: uma cópia nunca mistura ativações.
+void fill_telemetry_snapshot(TelemetrySnapshot* snapshot) {
+    lock_shared(&time_mutex);
+    snapshot->t = current_time;
+    unlock_shared(&time_mutex);
+
+    lock_shared(&x_state_mutex);
+    for (int i = 0; i < 3; i++) snapshot->x_state[i] = x_state->data[i][0];
+    unlock_shared(&x_state_mutex);
+
+    lock_shared(&y_output_mutex);
+    snapshot->y[0] = y_output->data[0][0];
+    snapshot->y[1] = y_output->data[1][0];
+    unlock_shared(&y_output_mutex);
+
+    lock_shared(&ref_input_mutex);
+    snapshot->ref[0] = ref_input->data[0][0];
+    snapshot->ref[1] = ref_input->data[1][0];
+    unlock_shared(&ref_input_mutex);
+
+    lock_shared(&ym_output_mutex);
+    snapshot->ym[0] = ym_output->data[0][0];
+    snapshot->ym[1] = ym_output->data[1][0];
+    unlock_shared(&ym_output_mutex);
+
+    lock_shared(&u_input_mutex);
+    snapshot->u[0] = u_input->data[0][0];
+    snapshot->u[1] = u_input->data[1][0];
+    unlock_shared(&u_input_mutex);
+
+    lock_shared(&alpha_mutex);
+    snapshot->alpha1 = alpha1;
+    snapshot->alpha2 = alpha2;
+    unlock_shared(&alpha_mutex);
+
+    snapshot->num_tasks = (NUM_TASKS < TELEMETRY_MAX_TASKS) ? NUM_TASKS : TELEMETRY_MAX_TASKS;
+    for (int i = 0; i < snapshot->num_tasks; i++) {
+        // Sem cópia consistente após as tentativas, publica a tarefa zerada nesta atualização
+        if (telemetryReadStats(&tasks[i].timing, &snapshot->tasks[i]) != 0) {
+            memset(&snapshot->tasks[i], 0, sizeof(TaskTimingStats));
+        }
+    }
+}
+
+// Aplica os comandos de ganho recebidos do monitor.
+void apply_telemetry_commands(void) {
+    TelemetryCommand cmd;
+    while (telemetryPollCommand(telemetry, &cmd) == 0) {
+        lock_shared(&alpha_mutex);
+        if (cmd.type == TELEMETRY_CMD_SET_ALPHA1) alpha1 = cmd.value;
+        if (cmd.type == TELEMETRY_CMD_SET_ALPHA2) alpha2 = cmd.value;
+        if (cmd.type == TELEMETRY_CMD_ADD_ALPHA1) alpha1 += cmd.value;
+        if (cmd.type == TELEMETRY_CMD_ADD_ALPHA2) alpha2 += cmd.value;
+        if (alpha1 < 0.1) alpha1 = 0.1;
+        if (alpha2 < 0.1) alpha2 = 0.1;
+        double alphas[2] = {alpha1, alpha2};
+        record_signal(TRACE_SIG_ALPHA, TASK_LOGGER, alphas, 2);
+        unlock_shared(&alpha_mutex);
+    }
+}
+
+int user_interface_init(void) {
+    output_file = fopen("output/simulation_output.txt", "w");
     if (!output_file) {
         perror("Erro ao abrir o arquivo de saída");
-        return NULL;
+        return -1;
     }
     //fprintf(output_file, "t\ty1\ty2\ttheta\txref\tyref\n");
     fprintf(output_file, "t\tx\ty\ttheta\txref\tyref\n");
 
-    FILE* timing_file = fopen("output/logger_timing.txt", "w");
-    fprintf(timing_file, "T(k)\n");
-    
-    struct timespec last_time;
-    clock_gettime(CLOCK_MONOTONIC, &last_time);
+    // Com telemetria, o processo de tempo real não toca no terminal
+    if (telemetry) return 0;
 
     // --- Configuração do terminal para leitura não bloqueante ---
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
+    struct termios newt;
     tcgetattr(STDIN_FILENO, &oldt);
     newt = oldt;
     newt.c_lflag &= ~(ICANON | ECHO);
@@ -460,59 +935,83 @@ void* user_interface_thread(void* arg) {
     oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
     fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
     // ---------------------------------------------------------
+    return 0;
+}
 
-    while (current_time < SIMULATION_TIME) {
-        // --- Leitura do teclado para alterar alphas ---
-        ch = getchar();
-        if (ch != EOF) {
-            pthread_mutex_lock(&alpha_mutex);
-            if (ch == 'q') alpha1 += 0.1;
-            if (ch == 'a') alpha1 = (alpha1 > 0.1) ? alpha1 - 0.1 : 0.1;
-            if (ch == 'w') alpha2 += 0.1;
-            if (ch == 's') alpha2 = (alpha2 > 0.1) ? alpha2 - 0.1 : 0.1;
-            pthread_mutex_unlock(&alpha_mutex);
-        }
+void user_interface_step(void) {
+    if (telemetry) {
+        apply_telemetry_commands();
+
+        TelemetrySnapshot snapshot;
+        fill_telemetry_snapshot(&snapshot);
+        snapshot.running = 1;
+        telemetryPublish(telemetry, &snapshot);
 
-        pthread_mutex_lock(&time_mutex);
-        double t = current_time;
-        pthread_mutex_unlock(&time_mutex);
-
-        pthread_mutex_lock(&y_output_mutex);
-        double y1 = y_output->data[0][0];
-        double y2 = y_output->data[1][0];
-        pthread_mutex_unlock(&y_output_mutex);
-
-        pthread_mutex_lock(&x_state_mutex);
-        double theta = x_state->data[2][0];
-        pthread_mutex_unlock(&x_state_mutex);
-
-        pthread_mutex_lock(&ref_input_mutex);
-        double xref = ref_input->data[0][0];
-        double yref = ref_input->data[1][0];
-        pthread_mutex_unlock(&ref_input_mutex);
-        
-        pthread_mutex_lock(&alpha_mutex);
-        double a1_val = alpha1;
-        double a2_val = alpha2;
-        pthread_mutex_unlock(&alpha_mutex);
-
-        // --- Exibição na Tela ---
-        printf("\033[H\033[J"); // Limpa o console
-        printf("--- Simulação Robô Lab 3 ---\n");
-        printf("Tempo: %.2f / %.2f s\n\n", t, SIMULATION_TIME);
-        printf("Posição Robô (y1, y2):   (%.3f, %.3f)\n", y1, y2);
-        printf("Referência   (xref, yref): (%.3f, %.3f)\n", xref, yref);
-        printf("Orientação (theta):      %.3f rad\n\n", theta);
-        printf("--- Controle ---\n");
-        printf("alpha1: %.2f  (q: aumenta | a: diminui)\n", a1_val);
-        printf("alpha2: %.2f  (w: aumenta | s: diminui)\n", a2_val);
-        fflush(stdout); // Garante que o texto seja impresso imediatamente
-
-        // Grava no arquivo de log
-        fprintf(output_file, "%f\t%f\t%f\t%f\t%f\t%f\n", t, y1, y2, theta, xref, yref);
-        
-        usleep(LOGGER_PERIOD_MS * 1000);
-        write_timing_info(timing_file, &last_time);
+        fprintf(output_file, "%f\t%f\t%f\t%f\t%f\t%f\n", snapshot.t, snapshot.y[0], snapshot.y[1],
+                snapshot.x_state[2], snapshot.ref[0], snapshot.ref[1]);
+        return;
+    }
+
+    // --- Leitura do teclado para alterar alphas ---
+    int ch = getchar();
+    if (ch != EOF) {
+        lock_shared(&alpha_mutex);
+        if (ch == 'q') alpha1 += 0.1;
+        if (ch == 'a') alpha1 = (alpha1 > 0.1) ? alpha1 - 0.1 : 0.1;
+        if (ch == 'w') alpha2 += 0.1;
+        if (ch == 's') alpha2 = (alpha2 > 0.1) ? alpha2 - 0.1 : 0.1;
+        double alphas[2] = {alpha1, alpha2};
+        record_signal(TRACE_SIG_ALPHA, TASK_LOGGER, alphas, 2);
+        unlock_shared(&alpha_mutex);
+    }
+
+    lock_shared(&time_mutex);
+    double t = current_time;
+    unlock_shared(&time_mutex);
+
+    lock_shared(&y_output_mutex);
+    double y1 = y_output->data[0][0];
+    double y2 = y_output->data[1][0];
+    unlock_shared(&y_output_mutex);
+
+    lock_shared(&x_state_mutex);
+    double theta = x_state->data[2][0];
+    unlock_shared(&x_state_mutex);
+
+    lock_shared(&ref_input_mutex);
+    double xref = ref_input->data[0][0];
+    double yref = ref_input->data[1][0];
+    unlock_shared(&ref_input_mutex);
+
+    lock_shared(&alpha_mutex);
+    double a1_val = alpha1;
+    double a2_val = alpha2;
+    unlock_shared(&alpha_mutex);
+
+    // --- Exibição na Tela ---
+    printf("\033[H\033[J"); // Limpa o console
+    printf("--- Simulação Robô Lab 3 ---\n");
+    printf("Tempo: %.2f / %.2f s\n\n", t, SIMULATION_TIME);
+    printf("Posição Robô (y1, y2):   (%.3f, %.3f)\n", y1, y2);
+    printf("Referência   (xref, yref): (%.3f, %.3f)\n", xref, yref);
+    printf("Orientação (theta):      %.3f rad\n\n", theta);
+    printf("--- Controle ---\n");
+    printf("alpha1: %.2f  (q: aumenta | a: diminui)\n", a1_val);
+    printf("alpha2: %.2f  (w: aumenta | s: diminui)\n", a2_val);
+    fflush(stdout); // Garante que o texto seja impresso imediatamente
+
+    // Grava no arquivo de log
+    fprintf(output_file, "%f\t%f\t%f\t%f\t%f\t%f\n", t, y1, y2, theta, xref, yref);
+}
+
+void user_interface_finish(void) {
+    if (telemetry) {
+        TelemetrySnapshot snapshot;
+        fill_telemetry_snapshot(&snapshot);
+        snapshot.running = 0;
+        telemetryPublish(telemetry, &snapshot);
+        fclose(output_file);
+        return;
     }
 
     // --- Restaura as configurações do terminal ---
@@ -521,7 +1020,5 @@ void* user_interface_thread(void* arg) {
     // -------------------------------------------
 
     fclose(output_file);
-    fclose(timing_file);
     printf("\n\nInterface finalizada. Log salvo.\n");
-    return NULL;
-}
\ No newline at end of file
+}
@@ -0,0 +1,362 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "matrixIO.h"
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+//------------------------------------------------------------------
+// Soma de Verificação
+//------------------------------------------------------------------
+
+// FNV-1a aplicado a palavras de 64 bits (uma multiplicação por elemento)
+static uint64_t checksumUpdate(uint64_t hash, const double* data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint64_t word;
+        memcpy(&word, &data[i], sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t matrixChecksum(const double* data, size_t count) {
+    return checksumUpdate(FNV_OFFSET, data, count);
+}
+
+//------------------------------------------------------------------
+// Gravação
+//------------------------------------------------------------------
+
+// writev pode gravar menos que o pedido: avança os vetores e repete
+static int writeAll(int fd, struct iovec* iov, int iovcnt) {
+    while (iovcnt > 0) {
+        ssize_t written = writev(fd, iov, iovcnt);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        while (iovcnt > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return 0;
+}
+
+static int rowsAreContiguous(const Matrix* matrix) {
+    for (int i = 1; i < matrix->rows; i++) {
+        if (matrix->data[i] != matrix->data[0] + (size_t)i * matrix->cols) return 0;
+    }
+    return 1;
+}
+
+int saveMatrixBinary(const Matrix* matrix, const char* path) {
+    if (matrix == NULL || matrix->rows <= 0 || matrix->cols <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    size_t row_bytes = (size_t)matrix->cols * sizeof(double);
+    MatrixFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MATRIX_FILE_MAGIC;
+    header.version = MATRIX_FILE_VERSION;
+    header.rows = (uint32_t)matrix->rows;
+    header.cols = (uint32_t)matrix->cols;
+    header.dtype = MATRIX_DTYPE_F64;
+    header.elem_size = sizeof(double);
+    header.stride = (uint64_t)matrix->cols;
+    header.data_offset = (sizeof(header) + MATRIX_FILE_ALIGN - 1) / MATRIX_FILE_ALIGN * MATRIX_FILE_ALIGN;
+    header.data_bytes = (uint64_t)matrix->rows * row_bytes;
+    header.checksum = FNV_OFFSET;
+    for (int i = 0; i < matrix->rows; i++) {
+        header.checksum = checksumUpdate(header.checksum, matrix->data[i], (size_t)matrix->cols);
+    }
+
+    // Cabeçalho, preenchimento até data_offset e dados: um vetor por bloco contíguo de linhas
+    static const char padding[MATRIX_FILE_ALIGN] = {0};
+    int contiguous = rowsAreContiguous(matrix);
+    int max_iov = 2 + (contiguous ? 1 : matrix->rows);
+    struct iovec* iov = (struct iovec*)malloc((size_t)max_iov * sizeof(struct iovec));
+    if (iov == NULL) return -1;
+
+    int iovcnt = 0;
+    iov[iovcnt++] = (struct iovec){&header, sizeof(header)};
+    if (header.data_offset > sizeof(header)) {
+        iov[iovcnt++] = (struct iovec){(void*)padding, header.data_offset - sizeof(header)};
+    }
+    if (contiguous) {
+        iov[iovcnt++] = (struct iovec){matrix->data[0], header.data_bytes};
+    } else {
+        for (int i = 0; i < matrix->rows; i++) iov[iovcnt++] = (struct iovec){matrix->data[i], row_bytes};
+    }
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        free(iov);
+        return -1;
+    }
+
+    // writev aceita no máximo IOV_MAX vetores por chamada
+    int status = 0;
+    long iov_max = sysconf(_SC_IOV_MAX);
+    if (iov_max <= 0) iov_max = 1024;
+    for (int first = 0; first < iovcnt && status == 0; first += (int)iov_max) {
+        int n = (iovcnt - first < iov_max) ? iovcnt - first : (int)iov_max;
+        status = writeAll(fd, iov + first, n);
+    }
+    free(iov);
+
+    int saved_errno = errno;
+    if (close(fd) != 0 && status == 0) return -1;
+    errno = saved_errno;
+    return status;
+}
+
+//------------------------------------------------------------------
+// Leitura Mapeada
+//------------------------------------------------------------------
+
+/*
+ * O restante da biblioteca supõe linhas contíguas (bloco rows x cols de
+ * createMatrix), então só aceita stride == cols. rows e cols viram int em
+ * Matrix, e rows * cols * sizeof(double) precisa caber em 64 bits.
+ */
+static int headerIsValid(const MatrixFileHeader* h, size_t file_size) {
+    if (h->magic != MATRIX_FILE_MAGIC || h->version != MATRIX_FILE_VERSION) return 0;
+    if (h->dtype != MATRIX_DTYPE_F64 || h->elem_size != sizeof(double)) return 0;
+    if (h->rows == 0 || h->cols == 0 || h->rows > INT_MAX || h->cols > INT_MAX) return 0;
+    if (h->stride != h->cols) return 0;
+    if (h->data_offset < sizeof(*h) || h->data_offset % MATRIX_FILE_ALIGN != 0) return 0;
+    if (h->data_offset > file_size) return 0;
+
+    uint64_t elements = (uint64_t)h->rows * h->cols;
+    if (elements > UINT64_MAX / sizeof(double)) return 0;
+    return h->data_bytes == elements * sizeof(double) && h->data_bytes <= file_size - h->data_offset;
+}
+
+MappedMatrix* mapMatrixBinary(const char* path, int flags) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MatrixFileHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+
+    // MAP_PRIVATE + PROT_WRITE: a visão pode ser alterada sem modificar o arquivo
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    const MatrixFileHeader* header = (const MatrixFileHeader*)map;
+    if (!headerIsValid(header, size)) {
+        munmap(map, size);
+        return NULL;
+    }
+    // Mesma soma de saveMatrixBinary: os rows x cols elementos, linha a linha
+    double* base = (double*)((char*)map + header->data_offset);
+    if ((flags & MATRIX_IO_VERIFY) && matrixChecksum(base, (size_t)header->rows * header->cols) != header->checksum) {
+        munmap(map, size);
+        return NULL;
+    }
+
+    MappedMatrix* mapped = (MappedMatrix*)malloc(sizeof(MappedMatrix));
+    double** rows = (double**)malloc(header->rows * sizeof(double*));
+    if (mapped == NULL || rows == NULL) {
+        free(mapped);
+        free(rows);
+        munmap(map, size);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < header->rows; i++) rows[i] = base + (size_t)i * header->cols;
+
+    mapped->matrix.rows = (int)header->rows;
+    mapped->matrix.cols = (int)header->cols;
+    mapped->matrix.data = rows;
+    mapped->map = map;
+    mapped->map_size = size;
+    return mapped;
+}
+
+void unmapMatrixBinary(MappedMatrix* mapped) {
+    if (mapped == NULL) return;
+    munmap(mapped->map, mapped->map_size);
+    free(mapped->matrix.data);
+    free(mapped);
+}
+
+//------------------------------------------------------------------
+// Importação de CSV
+//------------------------------------------------------------------
+
+static inline int isSeparator(char c) {
+    return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r';
+}
+
+/*
+ * Conversão rápida de um campo decimal. Quando a mantissa cabe exatamente em
+ * um double (até 2^53) e |expoente| <= 22, m * 10^e ou m / 10^e é uma única
+ * operação corretamente arredondada, com o mesmo resultado de strtod. Os
+ * demais casos (mantissas longas, expoentes grandes, nan, inf, hexadecimal
+ * "0x...") recorrem a strtod.
+ */
+static double parseNumber(char* start, char** end) {
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* p = start;
+    int negative = (*p == '-');
+    if (*p == '-' || *p == '+') p++;
+
+    uint64_t mantissa = 0;
+    int digits = 0;       // dígitos significativos acumulados na mantissa
+    int exponent = 0;
+    int any_digit = 0;
+    while (*p == '0') { p++; any_digit = 1; }
+    if (any_digit && (*p == 'x' || *p == 'X')) return strtod(start, end);
+    for (; *p >= '0' && *p <= '9'; p++, any_digit = 1) {
+        if (digits < 19) { mantissa = mantissa * 10 + (uint64_t)(*p - '0'); digits += (mantissa != 0); }
+        else exponent++;
+    }
+    if (*p == '.') {
+        p++;
+        for (; *p >= '0' && *p <= '9'; p++, any_digit = 1) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+    if (any_digit && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        int exp_negative = (*e == '-');
+        if (*e == '-' || *e == '+') e++;
+        if (*e >= '0' && *e <= '9') {
+            int value = 0;
+            for (; *e >= '0' && *e <= '9'; e++) {
+                if (value < 10000) value = value * 10 + (*e - '0');
+            }
+            exponent += exp_negative ? -value : value;
+            p = e;
+        }
+    }
+
+    if (!any_digit || digits >= 19 || mantissa > (1ULL << 53) || exponent < -22 || exponent > 22) {
+        return strtod(start, end);
+    }
+    *end = (char*)p;
+    double value = (exponent < 0) ? (double)mantissa / powers[-exponent] : (double)mantissa * powers[exponent];
+    return negative ? -value : value;
+}
+
+// Lê o arquivo inteiro em um buffer terminado em '\0' (exigido por strtod)
+static char* readWholeFile(const char* path, size_t* size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    char* buffer = (char*)malloc((size_t)st.st_size + 1);
+    size_t done = 0;
+    while (buffer != NULL && done < (size_t)st.st_size) {
+        ssize_t n = read(fd, buffer + done, (size_t)st.st_size - done);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            free(buffer);
+            buffer = NULL;
+            break;
+        }
+        done += (size_t)n;
+    }
+    close(fd);
+    if (buffer == NULL) return NULL;
+
+    buffer[done] = '\0';
+    *size = done;
+    return buffer;
+}
+
+/*
+ * Duas passagens sobre o buffer: a primeira só conta linhas e campos (sem
+ * converter nada) para alocar a matriz de uma vez; a segunda converte cada
+ * campo (parseNumber, com strtod como recurso) direto para o bloco contíguo
+ * da matriz.
+ */
+Matrix* importMatrixCSV(const char* path) {
+    size_t size;
+    char* buffer = readWholeFile(path, &size);
+    if (buffer == NULL) return NULL;
+
+    // 1ª passagem: dimensões
+    int rows = 0;
+    int cols = -1;
+    const char* p = buffer;
+    const char* end = buffer + size;
+    while (p < end) {
+        int fields = 0;
+        while (p < end && *p != '\n') {
+            while (p < end && isSeparator(*p)) p++;
+            if (p >= end || *p == '\n') break;
+            fields++;
+            while (p < end && *p != '\n' && !isSeparator(*p)) p++;
+        }
+        if (p < end) p++; // '\n'
+        if (fields == 0) continue; // linha vazia
+        if (cols < 0) cols = fields;
+        if (fields != cols) {
+            free(buffer);
+            return NULL;
+        }
+        rows++;
+    }
+    if (rows == 0) {
+        free(buffer);
+        return NULL;
+    }
+
+    Matrix* matrix = createMatrix(rows, cols);
+    if (matrix == NULL) {
+        free(buffer);
+        return NULL;
+    }
+
+    // 2ª passagem: conversão (as linhas são contíguas no bloco de createMatrix)
+    double* out = matrix->data[0];
+    size_t total = (size_t)rows * cols;
+    size_t k = 0;
+    char* q = buffer;
+    while (k < total) {
+        while (isSeparator(*q) || *q == '\n') q++;
+        char* next;
+        out[k++] = parseNumber(q, &next);
+        // O campo inteiro deve ser um número
+        if (next == q || !(isSeparator(*next) || *next == '\n' || *next == '\0')) {
+            freeMatrix(matrix);
+            free(buffer);
+            return NULL;
+        }
+        q = next;
+    }
+
+    free(buffer);
+    return matrix;
+}
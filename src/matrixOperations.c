@@ -4,231 +4,123 @@
 #include <math.h>
 
 //------------------------------------------------------------------
-// Funções de Gerenciamento de Memória
+// Instâncias do Modelo (matrixKernels.inc)
 //------------------------------------------------------------------
 
-Matrix* createMatrix(int rows, int cols) {
-    Matrix* matrix = (Matrix*)malloc(sizeof(Matrix));
-    if (matrix == NULL) return NULL;
-
-    matrix->rows = rows;
-    matrix->cols = cols;
-    matrix->data = (double**)malloc(rows * sizeof(double*));
-    if (matrix->data == NULL) {
-        free(matrix);
-        return NULL;
-    }
-
-    for (int i = 0; i < rows; i++) {
-        matrix->data[i] = (double*)malloc(cols * sizeof(double));
-        if (matrix->data[i] == NULL) {
-            for (int j = 0; j < i; j++) free(matrix->data[j]);
-            free(matrix->data);
-            free(matrix);
-            return NULL;
-        }
-    }
-    return matrix;
-}
-
-void freeMatrix(Matrix* matrix) {
-    if (matrix == NULL) return;
-
-    for (int i = 0; i < matrix->rows; i++) {
-        free(matrix->data[i]);
-    }
-    free(matrix->data);
-    free(matrix);
-}
-
-//------------------------------------------------------------------
-// Funções de Entrada e Saída (I/O)
-//------------------------------------------------------------------
-
-void scanMatrix(Matrix* matrix) {
-    printf("Digite os elementos da matriz (%.0dx%.0d):\n", (int)matrix->rows, (int)matrix->cols);
-    for (int i = 0; i < matrix->rows; i++) {
-        printf("  Linha %d: ", i + 1);
-        for (int j = 0; j < matrix->cols; j++) {
-            scanf("%lf", &matrix->data[i][j]); // %lf para ler doubles
-        }
-    }
-}
-
-void displayMatrix(Matrix* matrix) {
-    if (matrix == NULL) {
-        printf("Erro: Matriz nula.\n");
-        return;
-    }
-    printf("Matriz (%dx%d):\n", matrix->rows, matrix->cols);
-    for (int i = 0; i < matrix->rows; i++) {
-        for (int j = 0; j < matrix->cols; j++) {
-            printf("\t%.2f", matrix->data[i][j]); // %.2f para exibir com 2 casas decimais
-        }
-        printf("\n");
-    }
-}
+// matrixOperations.h remove MATRIX_FN ao fim das declarações; os kernels precisam dele de novo
+#define MATRIX_CONCAT_(a, b) a##b
+#define MATRIX_CONCAT(a, b) MATRIX_CONCAT_(a, b)
+#define MATRIX_FN(name) MATRIX_CONCAT(name, MATRIX_SUFFIX)
+
+// Precisão dupla: Matrix, createMatrix, gemv, ...
+#define MATRIX_REAL double
+#define MATRIX_TYPE Matrix
+#define MATRIX_SUFFIX
+#define MATRIX_ABS fabs
+#define MATRIX_SQRT sqrt
+#define MATRIX_SCAN_FORMAT "%lf"
+#include "matrixKernels.inc"
+#undef MATRIX_REAL
+#undef MATRIX_TYPE
+#undef MATRIX_SUFFIX
+#undef MATRIX_ABS
+#undef MATRIX_SQRT
+#undef MATRIX_SCAN_FORMAT
+
+// Precisão simples: MatrixF, createMatrixF, gemvF, ... (o dobro de lanes SIMD por vetor)
+#define MATRIX_REAL float
+#define MATRIX_TYPE MatrixF
+#define MATRIX_SUFFIX F
+#define MATRIX_ABS fabsf
+#define MATRIX_SQRT sqrtf
+#define MATRIX_SCAN_FORMAT "%f"
+#include "matrixKernels.inc"
+#undef MATRIX_REAL
+#undef MATRIX_TYPE
+#undef MATRIX_SUFFIX
+#undef MATRIX_ABS
+#undef MATRIX_SQRT
+#undef MATRIX_SCAN_FORMAT
+
+#undef MATRIX_FN
+#undef MATRIX_CONCAT
+#undef MATRIX_CONCAT_
 
 //------------------------------------------------------------------
-// Funções de Operações Matemáticas
+// Precisão Mista
 //------------------------------------------------------------------
 
-Matrix* addMatrix(Matrix* a, Matrix* b) {
-    if (a->rows != b->rows || a->cols != b->cols) return NULL;
-
-    Matrix* result = createMatrix(a->rows, a->cols);
-    if (result == NULL) return NULL;
-
-    for (int i = 0; i < a->rows; i++) {
-        for (int j = 0; j < a->cols; j++) {
-            result->data[i][j] = a->data[i][j] + b->data[i][j];
-        }
-    }
-    return result;
+int convertMatrixToFloat(const Matrix* src, MatrixF* dst) {
+    if (src->rows != dst->rows || src->cols != dst->cols) return -1;
+    const double* s = src->data[0];
+    float* d = dst->data[0];
+    int n = src->rows * src->cols;
+    for (int i = 0; i < n; i++) d[i] = (float)s[i];
+    return 0;
 }
 
-Matrix* subMatrix(Matrix* a, Matrix* b) {
-    if (a->rows != b->rows || a->cols != b->cols) return NULL;
-
-    Matrix* result = createMatrix(a->rows, a->cols);
-    if (result == NULL) return NULL;
-
-    for (int i = 0; i < a->rows; i++) {
-        for (int j = 0; j < a->cols; j++) {
-            result->data[i][j] = a->data[i][j] - b->data[i][j];
-        }
-    }
-    return result;
+int convertMatrixToDouble(const MatrixF* src, Matrix* dst) {
+    if (src->rows != dst->rows || src->cols != dst->cols) return -1;
+    const float* s = src->data[0];
+    double* d = dst->data[0];
+    int n = src->rows * src->cols;
+    for (int i = 0; i < n; i++) d[i] = s[i];
+    return 0;
 }
 
-Matrix* multiplyMatrix(Matrix* a, Matrix* b) {
-    if (a->cols != b->rows) return NULL;
-
-    Matrix* result = createMatrix(a->rows, b->cols);
-    if (result == NULL) return NULL;
-
-    for (int i = 0; i < result->rows; i++) {
-        for (int j = 0; j < result->cols; j++) {
-            result->data[i][j] = 0.0; // Inicializar com 0.0
-            for (int k = 0; k < a->cols; k++) {
-                result->data[i][j] += a->data[i][k] * b->data[k][j];
-            }
+// Refinamentos sobre a solução inicial em x. Retorna o número de iterações ou -1.
+static int refineSolution(const Matrix* A, const Matrix* b, Matrix* x, const MatrixF* LU, const int* pivots,
+                          MatrixF* correction, Matrix* residual, int max_iterations, double tolerance) {
+    int n = A->rows;
+    for (int it = 1; it <= max_iterations; it++) {
+        // r = b - A x em double
+        scaledAdd(1.0, b, 0.0, b, residual);
+        gemv(-1.0, A, x, 1.0, residual);
+
+        // A d = r em float, x += d em double
+        convertMatrixToFloat(residual, correction);
+        luSolveF(LU, pivots, correction, correction);
+        double* xv = x->data[0];
+        const float* dv = correction->data[0];
+        double update = 0.0;
+        for (int i = 0; i < n; i++) {
+            xv[i] += dv[i];
+            update = fmax(update, fabs((double)dv[i]));
         }
+        if (!isfinite(update)) return -1;
+        if (update <= tolerance * normInf(x)) return it;
     }
-    return result;
+    return -1;
 }
 
-Matrix* scalarMultiply(Matrix* matrix, double scalar) {
-    Matrix* result = createMatrix(matrix->rows, matrix->cols);
-    if (result == NULL) return NULL;
-
-    for (int i = 0; i < matrix->rows; i++) {
-        for (int j = 0; j < matrix->cols; j++) {
-            result->data[i][j] = matrix->data[i][j] * scalar;
-        }
-    }
-    return result;
-}
-
-Matrix* transposeMatrix(Matrix* matrix) {
-    Matrix* result = createMatrix(matrix->cols, matrix->rows);
-    if (result == NULL) return NULL;
-
-    for (int i = 0; i < matrix->rows; i++) {
-        for (int j = 0; j < matrix->cols; j++) {
-            result->data[j][i] = matrix->data[i][j];
-        }
-    }
-    return result;
-}
-
-double determinant(Matrix* matrix) {
-    // Apenas matrizes quadradas possuem determinante
-    if (matrix->rows != matrix->cols) {
-        return NAN;
-    }
-
-    int n = matrix->rows;
-    double det = 0.0;
-
-    // Caso base: matriz 1x1
-    if (n == 1) {
-        return matrix->data[0][0];
-    }
-
-    // Caso base: matriz 2x2
-    if (n == 2) {
-        return (matrix->data[0][0] * matrix->data[1][1]) - (matrix->data[0][1] * matrix->data[1][0]);
-    }
-
-    // Lógica recursiva para matrizes maiores (expansão pela primeira linha)
-    int sign = 1;
-    for (int j = 0; j < n; j++) {
-        Matrix* cofactor = getCofactor(matrix, 0, j);
-        det += sign * matrix->data[0][j] * determinant(cofactor);
-        sign = -sign;
-        freeMatrix(cofactor);
-    }
-
-    return det;
-}
-
-
 /*
- * Calcula a inversa de uma matriz.
- * Retorna NULL se a matriz não for quadrada ou se seu determinante for zero.
+ * O custo O(n^3) da fatoração fica todo em float; cada refinamento custa
+ * O(n^2) (um gemv em double e uma substituição em float).
  */
-Matrix* inverseMatrix(Matrix* matrix) {
-    if (matrix->rows != matrix->cols) return NULL;
-
-    double det = determinant(matrix);
-
-    // A matriz não é invertível se o determinante for zero
-    if (fabs(det) < 1e-9) return NULL;
-
-    int n = matrix->rows;
-
-    // 1. Calcular a matriz de cofatores
-    Matrix* cofactors = createMatrix(n, n);
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            Matrix* submatrix = getCofactor(matrix, i, j);
-            int sign = ((i + j) % 2 == 0) ? 1 : -1;
-            cofactors->data[i][j] = sign * determinant(submatrix);
-            freeMatrix(submatrix);
+int mixedPrecisionSolve(const Matrix* A, const Matrix* b, Matrix* x, int max_iterations, double tolerance) {
+    int n = A->rows;
+    if (A->cols != n || b->rows != n || b->cols != 1 || x->rows != n || x->cols != 1 || x == b) return -1;
+
+    MatrixF* LU = createMatrixF(n, n);
+    MatrixF* correction = createMatrixF(n, 1);
+    Matrix* residual = createMatrix(n, 1);
+    int* pivots = (int*)malloc((size_t)n * sizeof(int));
+
+    int result = -1;
+    if (LU != NULL && correction != NULL && residual != NULL && pivots != NULL) {
+        convertMatrixToFloat(A, LU);
+        if (luFactorF(LU, pivots) == 0) {
+            // Solução inicial em float
+            convertMatrixToFloat(b, correction);
+            luSolveF(LU, pivots, correction, correction);
+            convertMatrixToDouble(correction, x);
+            result = refineSolution(A, b, x, LU, pivots, correction, residual, max_iterations, tolerance);
         }
     }
 
-    // 2. Calcular a matriz adjunta (transposta da matriz de cofatores)
-    Matrix* adjugate = transposeMatrix(cofactors);
-    freeMatrix(cofactors); // Libera a matriz de cofatores
-
-    // 3. Calcular a inversa dividindo a adjunta pelo determinante
-    Matrix* inverse = createMatrix(n, n);
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            inverse->data[i][j] = adjugate->data[i][j] / det;
-        }
-    }
-    
-    freeMatrix(adjugate);
-    return inverse;
+    freeMatrixF(LU);
+    freeMatrixF(correction);
+    freeMatrix(residual);
+    free(pivots);
+    return result;
 }
-
-Matrix* getCofactor(Matrix* matrix, int p, int q) {
-    int n = matrix->rows;
-    Matrix* cofactor = createMatrix(n - 1, n - 1);
-    int row_c = 0, col_c = 0;
-
-    for (int i = 0; i < n; i++) {
-        if (i == p) continue;
-        col_c = 0;
-        for (int j = 0; j < n; j++) {
-            if (j == q) continue;
-            cofactor->data[row_c][col_c] = matrix->data[i][j];
-            col_c++;
-        }
-        row_c++;
-    }
-    return cofactor;
-}
\ No newline at end of file
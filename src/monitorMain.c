@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <unistd.h>
+#include <termios.h> // Para controle do terminal
+#include <fcntl.h>   // Para controle de arquivos
+#include "telemetry.h"
+
+// --- Monitor de Telemetria ---
+// Processo separado que lê o segmento publicado por `app_final --telemetry`,
+// desenha o estado no terminal e envia ajustes de ganho pelo anel de comandos.
+
+#define MONITOR_PERIOD_MS 100
+#define ALPHA_STEP 0.1
+
+void render(const TelemetrySnapshot* s) {
+    printf("\033[H\033[J"); // Limpa o console
+    printf("--- Monitor de Telemetria ---\n");
+    printf("Tempo: %.2f s %s\n\n", s->t, s->running ? "" : "(controlador encerrado)");
+    printf("Estado (xc, yc, theta):    (%.3f, %.3f, %.3f)\n", s->x_state[0], s->x_state[1], s->x_state[2]);
+    printf("Posição Robô (y1, y2):     (%.3f, %.3f)\n", s->y[0], s->y[1]);
+    printf("Modelo Ref. (ymx, ymy):    (%.3f, %.3f)\n", s->ym[0], s->ym[1]);
+    printf("Referência (xref, yref):   (%.3f, %.3f)\n", s->ref[0], s->ref[1]);
+    printf("Entrada (v, w):            (%.3f, %.3f)\n\n", s->u[0], s->u[1]);
+
+    printf("--- Tarefas (ms) ---\n");
+    printf("%-14s %7s %9s %9s %9s %9s %9s %7s\n", "Tarefa", "Período", "T(k)", "T máx", "|J| máx", "C(k)", "C máx", "Perdas");
+    for (int i = 0; i < s->num_tasks; i++) {
+        const TaskTimingStats* t = &s->tasks[i];
+        printf("%-14s %7d %9.3f %9.3f %9.3f %9.4f %9.4f %7ld\n",
+               t->name, t->period_ms, t->last_period_ms, t->max_period_ms, t->max_jitter_ms,
+               t->last_exec_ms, t->max_exec_ms, t->misses);
+    }
+
+    printf("\n--- Controle ---\n");
+    printf("alpha1: %.2f  (q: aumenta | a: diminui)\n", s->alpha1);
+    printf("alpha2: %.2f  (w: aumenta | s: diminui)\n", s->alpha2);
+    printf("x: sai do monitor\n");
+    fflush(stdout);
+}
+
+int main() {
+    TelemetrySegment* segment = telemetryAttach();
+    if (segment == NULL) {
+        fprintf(stderr, "Segmento %s não encontrado. Inicie ./bin/app_final --telemetry\n", TELEMETRY_SHM_NAME);
+        return 1;
+    }
+
+    // --- Configuração do terminal para leitura não bloqueante ---
+    struct termios oldt, newt;
+    tcgetattr(STDIN_FILENO, &oldt);
+    newt = oldt;
+    newt.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+    int oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
+    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
+    // ---------------------------------------------------------
+
+    TelemetrySnapshot snapshot;
+    int seen_running = 0;
+    for (;;) {
+        int ch = getchar();
+        if (ch == 'x') break;
+
+        TelemetryCommand cmd = {0};
+        int send = 1;
+        switch (ch) {
+            case 'q': cmd.type = TELEMETRY_CMD_ADD_ALPHA1; cmd.value = ALPHA_STEP; break;
+            case 'a': cmd.type = TELEMETRY_CMD_ADD_ALPHA1; cmd.value = -ALPHA_STEP; break;
+            case 'w': cmd.type = TELEMETRY_CMD_ADD_ALPHA2; cmd.value = ALPHA_STEP; break;
+            case 's': cmd.type = TELEMETRY_CMD_ADD_ALPHA2; cmd.value = -ALPHA_STEP; break;
+            default: send = 0;
+        }
+        if (send && telemetrySendCommand(segment, &cmd) != 0) {
+            fprintf(stderr, "Anel de comandos cheio; comando descartado\n");
+        }
+
+        if (telemetryRead(segment, &snapshot) == 0) {
+            render(&snapshot);
+            if (snapshot.running) seen_running = 1;
+            else if (seen_running) break;
+        }
+        usleep(MONITOR_PERIOD_MS * 1000);
+    }
+
+    // --- Restaura as configurações do terminal ---
+    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+    fcntl(STDIN_FILENO, F_SETFL, oldf);
+    // -------------------------------------------
+
+    telemetryDetach(segment);
+    printf("\nMonitor finalizado.\n");
+    return 0;
+}
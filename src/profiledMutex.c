@@ -0,0 +1,113 @@
+#include <string.h>
+#include <time.h>
+#include "profiledMutex.h"
+
+// Tarefa da thread corrente (atribuída pelo laço periódico)
+static __thread int current_task = -1;
+
+//------------------------------------------------------------------
+// Funções Auxiliares
+//------------------------------------------------------------------
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline int histogramBucket(uint64_t ns) {
+    int b = 63 - __builtin_clzll(ns | 1);
+    return (b < LOCK_HIST_BUCKETS) ? b : LOCK_HIST_BUCKETS - 1;
+}
+
+static inline LockTaskStats* taskStats(ProfiledMutex* m, int task) {
+    return (task >= 0 && task < LOCK_MAX_TASKS) ? &m->tasks[task] : NULL;
+}
+
+//------------------------------------------------------------------
+// Ciclo de Vida
+//------------------------------------------------------------------
+
+int profiledMutexInit(ProfiledMutex* m, const char* name) {
+    memset(m, 0, sizeof(*m));
+    m->name = name;
+    m->holder = -1;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    int err = pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    if (err == 0) err = pthread_mutex_init(&m->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return err;
+}
+
+void profiledMutexDestroy(ProfiledMutex* m) {
+    pthread_mutex_destroy(&m->mutex);
+}
+
+void profiledMutexSetTask(int task) {
+    current_task = task;
+}
+
+//------------------------------------------------------------------
+// Aquisição e Liberação
+//------------------------------------------------------------------
+
+void profiledLock(ProfiledMutex* m) {
+    // Caminho rápido: trava livre, sem espera a medir
+    uint64_t wait_ns = 0;
+    int contended = (pthread_mutex_trylock(&m->mutex) != 0);
+    if (contended) {
+        uint64_t start = now_ns();
+        pthread_mutex_lock(&m->mutex);
+        wait_ns = now_ns() - start;
+    }
+
+    // A partir daqui a thread detém a trava: o perfil pode ser atualizado sem atômicos
+    m->acquired_ns = now_ns();
+    m->holder = current_task;
+    m->acquisitions++;
+    if (contended) {
+        m->contended++;
+        m->wait_hist[histogramBucket(wait_ns)]++;
+        if (wait_ns > m->max_wait_ns) m->max_wait_ns = wait_ns;
+    }
+
+    LockTaskStats* st = taskStats(m, current_task);
+    if (st) {
+        st->acquisitions++;
+        st->contended += contended;
+        st->sum_wait_ns += wait_ns;
+        if (wait_ns > st->max_wait_ns) st->max_wait_ns = wait_ns;
+    }
+}
+
+void profiledUnlock(ProfiledMutex* m) {
+    uint64_t hold_ns = now_ns() - m->acquired_ns;
+    m->hold_hist[histogramBucket(hold_ns)]++;
+    if (hold_ns > m->max_hold_ns) m->max_hold_ns = hold_ns;
+
+    LockTaskStats* st = taskStats(m, m->holder);
+    if (st && hold_ns > st->max_hold_ns) st->max_hold_ns = hold_ns;
+
+    pthread_mutex_unlock(&m->mutex);
+}
+
+//------------------------------------------------------------------
+// Histogramas
+//------------------------------------------------------------------
+
+uint64_t lockHistogramQuantile(const uint64_t* hist, double q) {
+    uint64_t total = 0;
+    for (int b = 0; b < LOCK_HIST_BUCKETS; b++) total += hist[b];
+    if (total == 0) return 0;
+
+    uint64_t target = (uint64_t)(q * total);
+    if (target >= total) target = total - 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < LOCK_HIST_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen > target) return 1ULL << (b + 1);
+    }
+    return 1ULL << LOCK_HIST_BUCKETS;
+}
@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <getopt.h>
+#include "controlTasks.h"
+#include "trace.h"
+
+// --- Replay de Traces ---
+// Reexecuta o corpo de uma tarefa isoladamente, com as entradas reconstruídas
+// de um trace gravado por `app_final --record`, o mais rápido possível. Mede o
+// custo por ativação e compara as saídas com as que foram gravadas.
+
+#define DEFAULT_REPETITIONS 1000
+#define DEFAULT_TOLERANCE 1e-9
+
+typedef double SignalValues[TRACE_NUM_SIGNALS][TRACE_MAX_VALUES];
+
+// Uma ativação gravada: entradas lidas pela tarefa e saídas publicadas por ela
+typedef struct {
+    SignalValues inputs;
+    SignalValues expected;
+    unsigned int expected_mask;   // bit s ligado = sinal s publicado nesta ativação
+} ReplayJob;
+
+typedef struct {
+    const char* name;
+    int task;
+    void (*load)(const SignalValues in);
+    void (*step)(void);
+    void (*store)(SignalValues out);
+} ReplayStage;
+
+// --- Carga das entradas e leitura das saídas de cada estágio ---
+
+void load_ref_gen(const SignalValues in) {
+    current_time = in[TRACE_SIG_TIME][0];
+}
+
+void store_ref_gen(SignalValues out) {
+    out[TRACE_SIG_REF][0] = ref_input->data[0][0];
+    out[TRACE_SIG_REF][1] = ref_input->data[1][0];
+}
+
+void load_ref_model(const SignalValues in) {
+    ref_input->data[0][0] = in[TRACE_SIG_REF][0];
+    ref_input->data[1][0] = in[TRACE_SIG_REF][1];
+    alpha1 = in[TRACE_SIG_ALPHA][0];
+    alpha2 = in[TRACE_SIG_ALPHA][1];
+    set_ref_model_state(in[TRACE_SIG_YM_X][0], in[TRACE_SIG_YM_Y][0]);
+}
+
+void store_ref_model(SignalValues out) {
+    out[TRACE_SIG_YM_X][0] = ym_output->data[0][0];
+    out[TRACE_SIG_YM_X][1] = ym_dot_output->data[0][0];
+    out[TRACE_SIG_YM_Y][0] = ym_output->data[1][0];
+    out[TRACE_SIG_YM_Y][1] = ym_dot_output->data[1][0];
+}
+
+void load_control(const SignalValues in) {
+    y_output->data[0][0] = in[TRACE_SIG_Y][0];
+    y_output->data[1][0] = in[TRACE_SIG_Y][1];
+    ym_output->data[0][0] = in[TRACE_SIG_YM][0];
+    ym_output->data[1][0] = in[TRACE_SIG_YM][1];
+    ym_dot_output->data[0][0] = in[TRACE_SIG_YM_DOT][0];
+    ym_dot_output->data[1][0] = in[TRACE_SIG_YM_DOT][1];
+    alpha1 = in[TRACE_SIG_ALPHA][0];
+    alpha2 = in[TRACE_SIG_ALPHA][1];
+}
+
+void store_control(SignalValues out) {
+    out[TRACE_SIG_V][0] = v_input->data[0][0];
+    out[TRACE_SIG_V][1] = v_input->data[1][0];
+}
+
+void load_linearization(const SignalValues in) {
+    x_state->data[2][0] = in[TRACE_SIG_X_STATE][2];
+    v_input->data[0][0] = in[TRACE_SIG_V][0];
+    v_input->data[1][0] = in[TRACE_SIG_V][1];
+}
+
+void store_linearization(SignalValues out) {
+    out[TRACE_SIG_U][0] = u_input->data[0][0];
+    out[TRACE_SIG_U][1] = u_input->data[1][0];
+}
+
+void load_robot(const SignalValues in) {
+    u_input->data[0][0] = in[TRACE_SIG_U][0];
+    u_input->data[1][0] = in[TRACE_SIG_U][1];
+    for (int i = 0; i < 3; i++) x_state->data[i][0] = in[TRACE_SIG_X_STATE][i];
+    current_time = in[TRACE_SIG_TIME][0];
+}
+
+void store_robot(SignalValues out) {
+    for (int i = 0; i < 3; i++) out[TRACE_SIG_X_STATE][i] = x_state->data[i][0];
+    out[TRACE_SIG_Y][0] = y_output->data[0][0];
+    out[TRACE_SIG_Y][1] = y_output->data[1][0];
+    out[TRACE_SIG_TIME][0] = current_time;
+}
+
+ReplayStage stages[] = {
+    {"ref_gen", TASK_REF_GEN, load_ref_gen, reference_generation_step, store_ref_gen},
+    {"ref_model_x", TASK_REF_MODEL_X, load_ref_model, ref_model_x_step, store_ref_model},
+    {"ref_model_y", TASK_REF_MODEL_Y, load_ref_model, ref_model_y_step, store_ref_model},
+    {"control", TASK_CONTROL, load_control, control_step, store_control},
+    {"linearization", TASK_LINEARIZATION, load_linearization, linearization_step, store_linearization},
+    {"robot_sim", TASK_ROBOT_SIM, load_robot, robot_simulation_step, store_robot},
+};
+#define NUM_STAGES ((int)(sizeof(stages) / sizeof(stages[0])))
+
+// Reconstrói as ativações de uma tarefa percorrendo o trace em ordem de sequência.
+// As entradas partem dos últimos valores publicados antes da ativação (o que
+// inclui o estado interno da própria tarefa) e são sobrescritas pelos registros
+// de entrada que a tarefa gravou dentro das suas seções críticas.
+ReplayJob* build_jobs(const TraceRecord* records, size_t count, int task, int* num_jobs) {
+    int capacity = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].signal == TRACE_SIG_ACTIVATION && records[i].task == task) capacity++;
+    }
+    ReplayJob* jobs = (ReplayJob*)calloc(capacity > 0 ? capacity : 1, sizeof(ReplayJob));
+    if (jobs == NULL) return NULL;
+
+    SignalValues latest = {{0}};
+    latest[TRACE_SIG_ALPHA][0] = alpha1;
+    latest[TRACE_SIG_ALPHA][1] = alpha2;
+
+    int n = 0;
+    ReplayJob* current = NULL;
+    for (size_t i = 0; i < count; i++) {
+        const TraceRecord* r = &records[i];
+        int signal = r->signal & ~TRACE_INPUT_FLAG;
+        if (signal >= TRACE_NUM_SIGNALS) continue;
+
+        if (r->signal & TRACE_INPUT_FLAG) {
+            if (current && r->task == task) {
+                for (int k = 0; k < r->count; k++) current->inputs[signal][k] = r->values[k];
+            }
+            continue;
+        }
+
+        if (signal == TRACE_SIG_ACTIVATION) {
+            if (r->task == task) {
+                current = &jobs[n++];
+                memcpy(current->inputs, latest, sizeof(SignalValues));
+            }
+            continue;
+        }
+
+        if (current && r->task == task) {
+            for (int k = 0; k < r->count; k++) current->expected[signal][k] = r->values[k];
+            current->expected_mask |= 1u << signal;
+        }
+        for (int k = 0; k < r->count; k++) latest[signal][k] = r->values[k];
+    }
+
+    *num_jobs = n;
+    return jobs;
+}
+
+double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void print_usage(const char* program) {
+    printf("Uso: %s TRACE [opções]\n", program);
+    printf("  -s, --stage NOME       reexecuta apenas este estágio (padrão: todos)\n");
+    printf("  -n, --repetitions N    repetições do trace na medição (padrão: %d)\n", DEFAULT_REPETITIONS);
+    printf("  -t, --tolerance TOL    diferença máxima aceita nas saídas (padrão: %g)\n", DEFAULT_TOLERANCE);
+    printf("      --strict           retorna erro se alguma ativação divergir\n");
+    printf("Estágios:");
+    for (int i = 0; i < NUM_STAGES; i++) printf(" %s", stages[i].name);
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    const char* stage_name = NULL;
+    int repetitions = DEFAULT_REPETITIONS;
+    double tolerance = DEFAULT_TOLERANCE;
+    int strict = 0;
+
+    static struct option long_options[] = {
+        {"stage", required_argument, NULL, 's'},
+        {"repetitions", required_argument, NULL, 'n'},
+        {"tolerance", required_argument, NULL, 't'},
+        {"strict", no_argument, NULL, 'x'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:n:t:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 's': stage_name = optarg; break;
+            case 'n': repetitions = atoi(optarg); break;
+            case 't': tolerance = atof(optarg); break;
+            case 'x': strict = 1; break;
+            case 'h': print_usage(argv[0]); return 0;
+            default: print_usage(argv[0]); return 1;
+        }
+    }
+    if (optind >= argc || repetitions <= 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    size_t count = 0;
+    TraceRecord* records = loadTrace(argv[optind], &count);
+    if (records == NULL) {
+        fprintf(stderr, "Erro ao ler o trace %s\n", argv[optind]);
+        return 1;
+    }
+
+    if (init_shared_state() != 0) {
+        free(records);
+        return 1;
+    }
+
+    printf("--- Replay de %s (%zu registros, %d repetições) ---\n", argv[optind], count, repetitions);
+    printf("%-14s %8s %12s %14s %12s %10s\n", "Estágio", "Ativ.", "ns/ativação", "ativações/s", "Erro máx", "Divergem");
+
+    int status = 0;
+    int matched = 0;
+    for (int s = 0; s < NUM_STAGES; s++) {
+        const ReplayStage* stage = &stages[s];
+        if (stage_name && strcmp(stage_name, stage->name) != 0) continue;
+        matched = 1;
+
+        int num_jobs = 0;
+        ReplayJob* jobs = build_jobs(records, count, stage->task, &num_jobs);
+        if (jobs == NULL) {
+            status = 1;
+            break;
+        }
+        if (num_jobs == 0) {
+            printf("%-14s %8d %12s\n", stage->name, 0, "-");
+            free(jobs);
+            continue;
+        }
+
+        // Medição: somente carga das entradas + corpo da tarefa
+        double begin = now_ns();
+        for (int r = 0; r < repetitions; r++) {
+            for (int j = 0; j < num_jobs; j++) {
+                stage->load(jobs[j].inputs);
+                stage->step();
+            }
+        }
+        double ns_per_job = (now_ns() - begin) / ((double)repetitions * num_jobs);
+
+        // Verificação numérica contra as saídas gravadas
+        double max_error = 0.0;
+        int divergent = 0;
+        for (int j = 0; j < num_jobs; j++) {
+            SignalValues produced = {{0}};
+            stage->load(jobs[j].inputs);
+            stage->step();
+            stage->store(produced);
+
+            double job_error = 0.0;
+            for (int sig = 0; sig < TRACE_NUM_SIGNALS; sig++) {
+                if (!(jobs[j].expected_mask & (1u << sig))) continue;
+                for (int k = 0; k < TRACE_MAX_VALUES; k++) {
+                    double e = fabs(produced[sig][k] - jobs[j].expected[sig][k]);
+                    if (e > job_error) job_error = e;
+                }
+            }
+            if (job_error > max_error) max_error = job_error;
+            if (job_error > tolerance) divergent++;
+        }
+
+        printf("%-14s %8d %12.1f %14.0f %12.3g %10d\n",
+               stage->name, num_jobs, ns_per_job, 1e9 / ns_per_job, max_error, divergent);
+        if (strict && divergent > 0) status = 1;
+        free(jobs);
+    }
+
+    if (!matched) {
+        fprintf(stderr, "Estágio desconhecido: %s\n", stage_name);
+        status = 1;
+    }
+
+    free_shared_state();
+    free(records);
+    return status;
+}
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "rtGuard.h"
+
+// Implementações originais (o link com --wrap=SIMBOLO as renomeia para __real_SIMBOLO)
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static RtGuardMode guard_mode = RT_GUARD_OFF;
+static RtGuardTaskStats guard_stats[RT_GUARD_MAX_TASKS];
+
+// Estado da thread corrente
+static __thread int rt_phase = 0;
+static __thread int rt_task = -1;
+static __thread struct rusage step_start;
+
+//------------------------------------------------------------------
+// Funções Auxiliares
+//------------------------------------------------------------------
+
+static inline RtGuardTaskStats* currentStats(void) {
+    return (rt_task >= 0 && rt_task < RT_GUARD_MAX_TASKS) ? &guard_stats[rt_task] : NULL;
+}
+
+// Sem printf: o aviso não pode alocar de novo
+static void writeMessage(const char* text) {
+    ssize_t ignored = write(STDERR_FILENO, text, strlen(text));
+    (void)ignored;
+}
+
+static void trapAllocation(const char* function) {
+    RtGuardTaskStats* st = currentStats();
+    writeMessage("rtGuard: ");
+    writeMessage(function);
+    writeMessage(" na fase de tempo real da tarefa ");
+    writeMessage((st && st->name) ? st->name : "?");
+    writeMessage("\n");
+    abort();
+}
+
+// Conta uma chamada ao alocador; retorna 0 fora da fase de tempo real
+static inline int recordAllocatorCall(const char* function, int is_free) {
+    if (!rt_phase || guard_mode == RT_GUARD_OFF) return 0;
+    if (guard_mode == RT_GUARD_TRAP) trapAllocation(function);
+    RtGuardTaskStats* st = currentStats();
+    if (st) {
+        if (is_free) st->frees++;
+        else st->allocations++;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------
+// Alocador Interposto
+//------------------------------------------------------------------
+
+void* __wrap_malloc(size_t size) {
+    recordAllocatorCall("malloc", 0);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    recordAllocatorCall("calloc", 0);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    recordAllocatorCall("realloc", 0);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr) recordAllocatorCall("free", 1);
+    __real_free(ptr);
+}
+
+//------------------------------------------------------------------
+// Fase de Tempo Real
+//------------------------------------------------------------------
+
+RtGuardMode rtGuardInit(const char* const* names, int num_tasks) {
+    const char* env = getenv(RT_GUARD_ENV);
+    if (env == NULL || strcmp(env, "count") == 0) guard_mode = RT_GUARD_COUNT;
+    else if (strcmp(env, "trap") == 0) guard_mode = RT_GUARD_TRAP;
+    else guard_mode = RT_GUARD_OFF;
+
+    memset(guard_stats, 0, sizeof(guard_stats));
+    for (int i = 0; i < num_tasks && i < RT_GUARD_MAX_TASKS; i++) guard_stats[i].name = names[i];
+    return guard_mode;
+}
+
+const char* rtGuardModeName(RtGuardMode mode) {
+    switch (mode) {
+        case RT_GUARD_COUNT: return "count";
+        case RT_GUARD_TRAP: return "trap";
+        default: return "off";
+    }
+}
+
+void rtGuardEnter(int task) {
+    rt_task = task;
+    rt_phase = 1;
+}
+
+void rtGuardLeave(void) {
+    rt_phase = 0;
+}
+
+void rtGuardStepBegin(int task) {
+    rt_task = task;
+    if (guard_mode != RT_GUARD_OFF) getrusage(RUSAGE_THREAD, &step_start);
+}
+
+void rtGuardStepEnd(void) {
+    RtGuardTaskStats* st = currentStats();
+    if (guard_mode == RT_GUARD_OFF || st == NULL) return;
+
+    struct rusage now;
+    getrusage(RUSAGE_THREAD, &now);
+    long minor = now.ru_minflt - step_start.ru_minflt;
+    long major = now.ru_majflt - step_start.ru_majflt;
+    st->activations++;
+    st->minor_faults += minor;
+    st->major_faults += major;
+    st->voluntary_switches += now.ru_nvcsw - step_start.ru_nvcsw;
+    st->involuntary_switches += now.ru_nivcsw - step_start.ru_nivcsw;
+    if (minor + major > 0) st->faulting_activations++;
+}
+
+const RtGuardTaskStats* rtGuardStats(int task) {
+    return (task >= 0 && task < RT_GUARD_MAX_TASKS) ? &guard_stats[task] : NULL;
+}
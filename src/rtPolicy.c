@@ -0,0 +1,110 @@
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "rtPolicy.h"
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+/*
+ * A glibc não expõe sched_setattr; o layout abaixo é o de struct sched_attr
+ * (include/uapi/linux/sched/types.h), com os tempos em nanossegundos.
+ */
+typedef struct {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+} DeadlineSchedAttr;
+
+//------------------------------------------------------------------
+// Nomes
+//------------------------------------------------------------------
+
+int parsePolicy(const char* name, SchedPolicy* policy) {
+    if (strcmp(name, "other") == 0) *policy = POLICY_OTHER;
+    else if (strcmp(name, "fifo") == 0) *policy = POLICY_FIFO;
+    else if (strcmp(name, "deadline") == 0) *policy = POLICY_DEADLINE;
+    else return -1;
+    return 0;
+}
+
+const char* policyName(SchedPolicy policy) {
+    switch (policy) {
+        case POLICY_FIFO: return "fifo";
+        case POLICY_DEADLINE: return "deadline";
+        default: return "other";
+    }
+}
+
+//------------------------------------------------------------------
+// Admissão
+//------------------------------------------------------------------
+
+double rmsUtilizationBound(int n) {
+    if (n <= 0) return 0.0;
+    return n * (pow(2.0, 1.0 / n) - 1.0);
+}
+
+void admissionTest(SchedPolicy policy, const double* wcet_ms, const int* period_ms, int n, AdmissionResult* result) {
+    result->utilization = 0.0;
+    for (int i = 0; i < n; i++) result->utilization += wcet_ms[i] / period_ms[i];
+
+    if (policy == POLICY_FIFO) result->bound = rmsUtilizationBound(n);
+    else if (policy == POLICY_DEADLINE) result->bound = 1.0;
+    else result->bound = 0.0;
+
+    result->admitted = (policy == POLICY_OTHER) || (result->utilization <= result->bound);
+}
+
+//------------------------------------------------------------------
+// Aplicação
+//------------------------------------------------------------------
+
+int applySchedPolicy(SchedPolicy policy, int priority, double runtime_ms, int period_ms) {
+    if (policy == POLICY_FIFO) {
+        struct sched_param param = {.sched_priority = priority};
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+
+    if (policy == POLICY_DEADLINE) {
+        DeadlineSchedAttr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.sched_policy = SCHED_DEADLINE;
+        attr.sched_runtime = (uint64_t)(runtime_ms * 1e6);
+        attr.sched_deadline = (uint64_t)period_ms * 1000000ULL;
+        attr.sched_period = attr.sched_deadline;
+        if (syscall(SYS_sched_setattr, 0, &attr, 0) != 0) return errno;
+        return 0;
+    }
+
+    struct sched_param param = {.sched_priority = 0};
+    return pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+}
+
+SchedPolicy applySchedPolicyWithFallback(const char* name, SchedPolicy policy, int priority, double runtime_ms,
+                                         int period_ms) {
+    while (policy != POLICY_OTHER) {
+        int err = applySchedPolicy(policy, priority, runtime_ms, period_ms);
+        if (err == 0) return policy;
+        SchedPolicy fallback = (policy == POLICY_DEADLINE) ? POLICY_FIFO : POLICY_OTHER;
+        fprintf(stderr, "Aviso: %s recusou %s (%s); usando %s\n", name, policyName(policy), strerror(err),
+                policyName(fallback));
+        policy = fallback;
+    }
+    int err = applySchedPolicy(POLICY_OTHER, 0, 0.0, 0);
+    if (err != 0) fprintf(stderr, "Aviso: %s não voltou para other (%s)\n", name, strerror(err));
+    return POLICY_OTHER;
+}
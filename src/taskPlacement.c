@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taskPlacement.h"
+
+//------------------------------------------------------------------
+// Interpretação da Especificação
+//------------------------------------------------------------------
+
+int parseCpuList(const char* list, cpu_set_t* set) {
+    CPU_ZERO(set);
+    if (list == NULL || *list == '\0') return -1;
+
+    const char* p = list;
+    while (*p != '\0') {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) return -1;
+
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) return -1;
+        }
+        if (last >= CPU_SETSIZE) return -1;
+
+        for (long cpu = first; cpu <= last; cpu++) {
+            CPU_SET((int)cpu, set);
+        }
+
+        if (*end == ',') {
+            end++;
+            if (*end == '\0') return -1;   // vírgula final sem CPU
+        } else if (*end != '\0') {
+            return -1;
+        }
+        p = end;
+    }
+    return 0;
+}
+
+static int isKnownKey(const char* key, const char* const* keys) {
+    if (strcmp(key, "all") == 0) return 1;
+    for (int i = 0; keys[i] != NULL; i++) {
+        if (strcmp(key, keys[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+int resolvePlacement(const char* spec, const char* task_name, const char* group, const char* const* keys,
+                     TaskPlacement* placement) {
+    CPU_ZERO(&placement->cpus);
+    placement->pinned = 0;
+    placement->last_cpu = -1;
+    placement->migrations = 0;
+    placement->samples = 0;
+
+    if (spec == NULL) return 0;
+
+    char* copy = strdup(spec);
+    if (copy == NULL) return -1;
+
+    // Nível de especificidade da entrada escolhida: 3 = tarefa, 2 = grupo, 1 = all
+    int best_rank = 0;
+    int status = 0;
+    char* saveptr = NULL;
+
+    for (char* entry = strtok_r(copy, ";", &saveptr); entry != NULL; entry = strtok_r(NULL, ";", &saveptr)) {
+        char* eq = strchr(entry, '=');
+        if (eq == NULL) {
+            status = -1;
+            break;
+        }
+        *eq = '\0';
+
+        cpu_set_t cpus;
+        if (!isKnownKey(entry, keys) || parseCpuList(eq + 1, &cpus) != 0) {
+            status = -1;
+            break;
+        }
+
+        int rank = 0;
+        if (strcmp(entry, task_name) == 0) rank = 3;
+        else if (group != NULL && strcmp(entry, group) == 0) rank = 2;
+        else if (strcmp(entry, "all") == 0) rank = 1;
+
+        if (rank > best_rank) {
+            best_rank = rank;
+            placement->cpus = cpus;
+            placement->pinned = 1;
+        }
+    }
+
+    free(copy);
+    return status;
+}
+
+//------------------------------------------------------------------
+// Aplicação e Verificação
+//------------------------------------------------------------------
+
+int applyPlacementAttr(pthread_attr_t* attr, const TaskPlacement* placement) {
+    if (!placement->pinned) return 0;
+    return pthread_attr_setaffinity_np(attr, sizeof(cpu_set_t), &placement->cpus);
+}
+
+int verifyPlacement(pthread_t thread, const TaskPlacement* placement) {
+    if (!placement->pinned) return 0;
+
+    cpu_set_t actual;
+    if (pthread_getaffinity_np(thread, sizeof(cpu_set_t), &actual) != 0) return -1;
+    return CPU_EQUAL(&actual, &placement->cpus) ? 0 : -1;
+}
+
+void samplePlacement(TaskPlacement* placement) {
+    int cpu = sched_getcpu();
+    if (cpu < 0) return;
+
+    if (placement->last_cpu >= 0 && cpu != placement->last_cpu) {
+        placement->migrations++;
+    }
+    placement->last_cpu = cpu;
+    placement->samples++;
+}
+
+void formatCpuList(const cpu_set_t* set, char* buffer, int size) {
+    int used = 0;
+    buffer[0] = '\0';
+
+    for (int cpu = 0; cpu < CPU_SETSIZE && used < size; cpu++) {
+        if (!CPU_ISSET(cpu, set)) continue;
+
+        // Agrupa CPUs consecutivas em intervalos
+        int last = cpu;
+        while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set)) last++;
+
+        const char* sep = (used > 0) ? "," : "";
+        if (last == cpu) used += snprintf(buffer + used, size - used, "%s%d", sep, cpu);
+        else used += snprintf(buffer + used, size - used, "%s%d-%d", sep, cpu, last);
+        cpu = last;
+    }
+}
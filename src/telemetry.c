@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "telemetry.h"
+
+#define TELEMETRY_READ_RETRIES 1000
+
+//------------------------------------------------------------------
+// Criação e Anexação do Segmento
+//------------------------------------------------------------------
+
+TelemetrySegment* telemetryCreate(void) {
+    int fd = shm_open(TELEMETRY_SHM_NAME, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) return NULL;
+
+    if (ftruncate(fd, sizeof(TelemetrySegment)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    void* addr = mmap(NULL, sizeof(TelemetrySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return NULL;
+
+    TelemetrySegment* segment = (TelemetrySegment*)addr;
+    memset(segment, 0, sizeof(TelemetrySegment));
+    atomic_init(&segment->sequence, 0);
+    atomic_init(&segment->cmd_head, 0);
+    atomic_init(&segment->cmd_tail, 0);
+    segment->version = TELEMETRY_VERSION;
+    segment->magic = TELEMETRY_MAGIC;
+    return segment;
+}
+
+void telemetryDestroy(TelemetrySegment* segment) {
+    if (segment == NULL) return;
+    munmap(segment, sizeof(TelemetrySegment));
+    shm_unlink(TELEMETRY_SHM_NAME);
+}
+
+TelemetrySegment* telemetryAttach(void) {
+    int fd = shm_open(TELEMETRY_SHM_NAME, O_RDWR, 0);
+    if (fd < 0) return NULL;
+
+    void* addr = mmap(NULL, sizeof(TelemetrySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return NULL;
+
+    TelemetrySegment* segment = (TelemetrySegment*)addr;
+    if (segment->magic != TELEMETRY_MAGIC || segment->version != TELEMETRY_VERSION) {
+        munmap(addr, sizeof(TelemetrySegment));
+        return NULL;
+    }
+    return segment;
+}
+
+void telemetryDetach(TelemetrySegment* segment) {
+    if (segment == NULL) return;
+    munmap(segment, sizeof(TelemetrySegment));
+}
+
+//------------------------------------------------------------------
+// Seqlock
+//------------------------------------------------------------------
+
+// Escritor único: sequência ímpar durante a escrita, par ao terminar.
+static unsigned int seqlockWriteBegin(atomic_uint* sequence) {
+    unsigned int seq = atomic_load_explicit(sequence, memory_order_relaxed);
+    atomic_store_explicit(sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return seq;
+}
+
+static void seqlockWriteEnd(atomic_uint* sequence, unsigned int seq) {
+    atomic_store_explicit(sequence, seq + 2, memory_order_release);
+}
+
+// Copia src em dst até obter uma cópia sem escrita concorrente. Retorna 0, ou -1 se desistir.
+static int seqlockRead(atomic_uint* sequence, void* dst, const void* src, size_t size) {
+    for (int attempt = 0; attempt < TELEMETRY_READ_RETRIES; attempt++) {
+        unsigned int before = atomic_load_explicit(sequence, memory_order_acquire);
+        if (before & 1u) continue;
+
+        memcpy(dst, src, size);
+        atomic_thread_fence(memory_order_acquire);
+
+        unsigned int after = atomic_load_explicit(sequence, memory_order_relaxed);
+        if (before == after) return 0;
+    }
+    return -1;
+}
+
+void telemetryPublish(TelemetrySegment* segment, const TelemetrySnapshot* snapshot) {
+    unsigned int seq = seqlockWriteBegin(&segment->sequence);
+    memcpy(&segment->snapshot, snapshot, sizeof(TelemetrySnapshot));
+    seqlockWriteEnd(&segment->sequence, seq);
+}
+
+int telemetryRead(TelemetrySegment* segment, TelemetrySnapshot* snapshot) {
+    return seqlockRead(&segment->sequence, snapshot, &segment->snapshot, sizeof(TelemetrySnapshot));
+}
+
+//------------------------------------------------------------------
+// Anel de Comandos
+//------------------------------------------------------------------
+
+int telemetrySendCommand(TelemetrySegment* segment, const TelemetryCommand* command) {
+    unsigned int head = atomic_load_explicit(&segment->cmd_head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&segment->cmd_tail, memory_order_acquire);
+    if (head - tail >= TELEMETRY_CMD_CAPACITY) return -1;
+
+    segment->commands[head % TELEMETRY_CMD_CAPACITY] = *command;
+    atomic_store_explicit(&segment->cmd_head, head + 1, memory_order_release);
+    return 0;
+}
+
+int telemetryPollCommand(TelemetrySegment* segment, TelemetryCommand* command) {
+    unsigned int tail = atomic_load_explicit(&segment->cmd_tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&segment->cmd_head, memory_order_acquire);
+    if (head == tail) return -1;
+
+    *command = segment->commands[tail % TELEMETRY_CMD_CAPACITY];
+    atomic_store_explicit(&segment->cmd_tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+//------------------------------------------------------------------
+// Estatísticas de Temporização
+//------------------------------------------------------------------
+
+void updateTimingStats(TaskTimingStats* stats, double period_ms, double exec_ms, double latency_ms, int missed) {
+    stats->activations++;
+    if (missed) stats->misses++;
+
+    stats->last_exec_ms = exec_ms;
+    stats->sum_exec_ms += exec_ms;
+    if (exec_ms > stats->max_exec_ms) stats->max_exec_ms = exec_ms;
+    if (latency_ms > stats->max_latency_ms) stats->max_latency_ms = latency_ms;
+
+    // O primeiro T(k) não existe (não há ativação anterior)
+    if (period_ms <= 0) return;
+
+    if (stats->period_samples == 0 || period_ms < stats->min_period_ms) stats->min_period_ms = period_ms;
+    if (period_ms > stats->max_period_ms) stats->max_period_ms = period_ms;
+    stats->period_samples++;
+    stats->last_period_ms = period_ms;
+    stats->sum_period_ms += period_ms;
+
+    double jitter = fabs(period_ms - stats->period_ms);
+    if (jitter > stats->max_jitter_ms) stats->max_jitter_ms = jitter;
+}
+
+void telemetryRecordActivation(TaskStatsCell* cell, double period_ms, double exec_ms, double latency_ms, int missed) {
+    unsigned int seq = seqlockWriteBegin(&cell->sequence);
+    updateTimingStats(&cell->stats, period_ms, exec_ms, latency_ms, missed);
+    seqlockWriteEnd(&cell->sequence, seq);
+}
+
+int telemetryReadStats(TaskStatsCell* cell, TaskTimingStats* stats) {
+    return seqlockRead(&cell->sequence, stats, &cell->stats, sizeof(TaskTimingStats));
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "trace.h"
+
+//------------------------------------------------------------------
+// Gravação
+//------------------------------------------------------------------
+
+TraceRecorder* createTraceRecorder(size_t capacity) {
+    TraceRecorder* recorder = (TraceRecorder*)malloc(sizeof(TraceRecorder));
+    if (recorder == NULL) return NULL;
+
+    // calloc + memset garantem que as páginas do buffer já estejam mapeadas
+    recorder->records = (TraceRecord*)calloc(capacity, sizeof(TraceRecord));
+    if (recorder->records == NULL) {
+        free(recorder);
+        return NULL;
+    }
+    memset(recorder->records, 0, capacity * sizeof(TraceRecord));
+
+    recorder->capacity = capacity;
+    atomic_init(&recorder->next, 0);
+    clock_gettime(CLOCK_MONOTONIC, &recorder->start);
+    return recorder;
+}
+
+void freeTraceRecorder(TraceRecorder* recorder) {
+    if (recorder == NULL) return;
+    free(recorder->records);
+    free(recorder);
+}
+
+void traceRecord(TraceRecorder* recorder, int signal, int task, const double* values, int count) {
+    size_t seq = atomic_fetch_add_explicit(&recorder->next, 1, memory_order_relaxed);
+    if (seq >= recorder->capacity) return; // buffer cheio: contado como perdido em saveTrace
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    TraceRecord* r = &recorder->records[seq];
+    r->timestamp_ns = (uint64_t)(now.tv_sec - recorder->start.tv_sec) * 1000000000ULL + (now.tv_nsec - recorder->start.tv_nsec);
+    r->sequence = (uint32_t)seq;
+    r->signal = (uint8_t)signal;
+    r->count = (uint8_t)((count > TRACE_MAX_VALUES) ? TRACE_MAX_VALUES : count);
+    r->task = (uint16_t)task;
+    for (int i = 0; i < r->count; i++) r->values[i] = values[i];
+}
+
+int saveTrace(TraceRecorder* recorder, const char* path) {
+    size_t total = atomic_load(&recorder->next);
+    size_t count = (total < recorder->capacity) ? total : recorder->capacity;
+
+    TraceHeader header = {TRACE_MAGIC, TRACE_VERSION, count, total - count};
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) return -1;
+
+    int status = 0;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) status = -1;
+    if (status == 0 && fwrite(recorder->records, sizeof(TraceRecord), count, file) != count) status = -1;
+    if (fclose(file) != 0) status = -1;
+    return status;
+}
+
+//------------------------------------------------------------------
+// Leitura
+//------------------------------------------------------------------
+
+// Registro que o replay pode indexar sem sair de SignalValues
+static int recordIsValid(const TraceRecord* r) {
+    return (r->signal & ~TRACE_INPUT_FLAG) < TRACE_NUM_SIGNALS && r->count <= TRACE_MAX_VALUES;
+}
+
+TraceRecord* loadTrace(const char* path, size_t* count) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    // O count do cabeçalho só é aceito se bater com o tamanho do arquivo (antes de qualquer alocação)
+    TraceHeader header;
+    struct stat st;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != TRACE_MAGIC || header.version != TRACE_VERSION ||
+        fstat(fileno(file), &st) != 0 || (uint64_t)st.st_size < sizeof(header) ||
+        ((uint64_t)st.st_size - sizeof(header)) % sizeof(TraceRecord) != 0 ||
+        header.count != ((uint64_t)st.st_size - sizeof(header)) / sizeof(TraceRecord)) {
+        fclose(file);
+        return NULL;
+    }
+
+    TraceRecord* records = (TraceRecord*)malloc((header.count > 0 ? header.count : 1) * sizeof(TraceRecord));
+    if (records == NULL || fread(records, sizeof(TraceRecord), header.count, file) != header.count) {
+        free(records);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    for (uint64_t i = 0; i < header.count; i++) {
+        if (!recordIsValid(&records[i])) {
+            fprintf(stderr, "Registro %llu do trace inválido (sinal %u, %u valores)\n", (unsigned long long)i,
+                    records[i].signal, records[i].count);
+            free(records);
+            return NULL;
+        }
+    }
+
+    if (header.dropped > 0) {
+        fprintf(stderr, "Aviso: o trace perdeu %llu registros (buffer cheio)\n", (unsigned long long)header.dropped);
+    }
+    *count = header.count;
+    return records;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "matrixOperations.h"
+#include "batchedMatrix.h"
+
+#define BATCH_COUNT 37   // não múltiplo da largura SIMD, para exercitar o resto do laço
+#define TOLERANCE 1e-9
+
+// Problema i de um lote intercalado -> Matrix K x K
+Matrix* extractMatrix(int K, int count, const double* A, int i) {
+    Matrix* m = createMatrix(K, K);
+    for (int r = 0; r < K; r++) {
+        for (int c = 0; c < K; c++) m->data[r][c] = A[(r * K + c) * count + i];
+    }
+    return m;
+}
+
+Matrix* extractVector(int K, int count, const double* x, int i) {
+    Matrix* v = createMatrix(K, 1);
+    for (int r = 0; r < K; r++) v->data[r][0] = x[r * count + i];
+    return v;
+}
+
+// Lote aleatório com diagonal reforçada (bem condicionado)
+void fillBatch(int K, int count, double* A, double* x) {
+    for (int i = 0; i < count; i++) {
+        for (int r = 0; r < K; r++) {
+            for (int c = 0; c < K; c++) {
+                double value = (double)rand() / RAND_MAX - 0.5;
+                A[(r * K + c) * count + i] = (r == c) ? value + K : value;
+            }
+            x[r * count + i] = (double)rand() / RAND_MAX - 0.5;
+        }
+    }
+}
+
+// Compara cada operação em lote com a versão escalar da biblioteca
+int checkSize(int K) {
+    int n = BATCH_COUNT;
+    int failures = 0;
+    double* A = malloc(sizeof(double) * K * K * n);
+    double* B = malloc(sizeof(double) * K * K * n);
+    double* C = malloc(sizeof(double) * K * K * n);
+    double* Ainv = malloc(sizeof(double) * K * K * n);
+    double* b = malloc(sizeof(double) * K * n);
+    double* x = malloc(sizeof(double) * K * n);
+    double* y = malloc(sizeof(double) * K * n);
+    double* det = malloc(sizeof(double) * n);
+
+    fillBatch(K, n, A, b);
+    fillBatch(K, n, B, y);
+
+    int singular = 0;
+    if (K == 2) {
+        batchDet2x2(n, A, det);
+        singular += batchInverse2x2(n, A, Ainv);
+        singular += batchSolve2x2(n, A, b, x);
+        batchMultiply2x2(n, A, B, C);
+        batchMatVec2x2(n, A, b, y);
+    } else if (K == 3) {
+        batchDet3x3(n, A, det);
+        singular += batchInverse3x3(n, A, Ainv);
+        singular += batchSolve3x3(n, A, b, x);
+        batchMultiply3x3(n, A, B, C);
+        batchMatVec3x3(n, A, b, y);
+    } else {
+        batchDet4x4(n, A, det);
+        singular += batchInverse4x4(n, A, Ainv);
+        singular += batchSolve4x4(n, A, b, x);
+        batchMultiply4x4(n, A, B, C);
+        batchMatVec4x4(n, A, b, y);
+    }
+    failures += (singular != 0);
+
+    double worst = 0.0;
+    for (int i = 0; i < n; i++) {
+        Matrix* a = extractMatrix(K, n, A, i);
+        Matrix* bm = extractMatrix(K, n, B, i);
+        Matrix* bv = extractVector(K, n, b, i);
+
+        Matrix* inv_ref = inverseMatrix(a);
+        Matrix* mul_ref = multiplyMatrix(a, bm);
+        Matrix* mv_ref = multiplyMatrix(a, bv);
+        Matrix* sol_ref = multiplyMatrix(inv_ref, bv);
+
+        Matrix* inv = extractMatrix(K, n, Ainv, i);
+        Matrix* mul = extractMatrix(K, n, C, i);
+        Matrix* mv = extractVector(K, n, y, i);
+        Matrix* sol = extractVector(K, n, x, i);
+
+        Matrix* d_inv = subMatrix(inv, inv_ref);
+        Matrix* d_mul = subMatrix(mul, mul_ref);
+        Matrix* d_mv = subMatrix(mv, mv_ref);
+        Matrix* d_sol = subMatrix(sol, sol_ref);
+        double errors[5] = {
+            fabs(det[i] - determinant(a)),
+            normInf(d_inv), normInf(d_mul), normInf(d_mv), normInf(d_sol),
+        };
+
+        for (int e = 0; e < 5; e++) {
+            if (errors[e] > worst) worst = errors[e];
+        }
+
+        freeMatrix(a); freeMatrix(bm); freeMatrix(bv);
+        freeMatrix(inv_ref); freeMatrix(mul_ref); freeMatrix(mv_ref); freeMatrix(sol_ref);
+        freeMatrix(inv); freeMatrix(mul); freeMatrix(mv); freeMatrix(sol);
+        freeMatrix(d_inv); freeMatrix(d_mul); freeMatrix(d_mv); freeMatrix(d_sol);
+    }
+    failures += (worst > TOLERANCE);
+    printf("%dx%d: %d problemas, erro max vs. escalar = %.3g, singulares = %d\n", K, K, n, worst, singular);
+
+    free(A); free(B); free(C); free(Ainv);
+    free(b); free(x); free(y); free(det);
+    return failures;
+}
+
+int main() {
+    int failures = 0;
+    srand(7);
+
+    printf("--- TESTE: LOTES vs. OPERACOES ESCALARES ---\n");
+    failures += checkSize(2);
+    failures += checkSize(3);
+    failures += checkSize(4);
+
+    // Lote 2x2 misto: o problema 1 é singular e deve sair zerado sem afetar os demais
+    printf("\n--- TESTE: PROBLEMA SINGULAR NO LOTE ---\n");
+    enum { N = 3 };
+    double A[4 * N] = {
+        // a00        a01          a10          a11
+        2, 1, 4,     0, 2, 1,     0, 2, 0,     2, 4, 1,
+    };
+    double b[2 * N] = {2, 1, 7,   4, 1, 4};
+    double x[2 * N];
+    double Ainv[4 * N];
+    int singular_inv = batchInverse2x2(N, A, Ainv);
+    int singular_sol = batchSolve2x2(N, A, b, x);
+    printf("Singulares: inversa = %d, solucao = %d\n", singular_inv, singular_sol);
+    printf("x0 = [%g, %g], x1 = [%g, %g], x2 = [%g, %g]\n", x[0], x[N], x[1], x[N + 1], x[2], x[N + 2]);
+
+    failures += (singular_inv != 1) || (singular_sol != 1);
+    failures += (x[1] != 0.0) || (x[N + 1] != 0.0);
+    for (int e = 0; e < 4; e++) failures += (Ainv[e * N + 1] != 0.0);
+    failures += fabs(x[0] - 1.0) > TOLERANCE || fabs(x[N] - 2.0) > TOLERANCE;    // diag(2, 2)
+    failures += fabs(x[2] - 0.75) > TOLERANCE || fabs(x[N + 2] - 4.0) > TOLERANCE; // [[4, 1], [0, 1]]
+
+    if (failures == 0) {
+        printf("\nSUCESSO: lotes coincidem com as operacoes escalares.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include "cyclicSchedule.h"
+
+int main() {
+    int failures = 0;
+
+    // === 1. TESTE: Períodos do app_final ===
+    printf("--- TESTE: TABELA DE QUADROS DO APP_FINAL ---\n");
+    const char* names[] = {"ref_gen", "ref_model_x", "ref_model_y", "control", "linearization", "robot_sim", "logger"};
+    int periods[] = {120, 50, 50, 50, 40, 30, 100};
+    int n = 7;
+
+    CyclicSchedule schedule;
+    if (buildCyclicSchedule(periods, n, &schedule) != 0) {
+        printf("FALHA: tabela nao gerada.\n");
+        return 1;
+    }
+    printCyclicSchedule(&schedule, names);
+    failures += (schedule.minor_ms != 10) || (schedule.major_ms != 600) || (schedule.num_frames != 60);
+
+    // Cada tarefa aparece exatamente hiperperíodo / período vezes, a cada período
+    for (int i = 0; i < n; i++) {
+        int count = 0;
+        int last_frame = -1;
+        for (int f = 0; f < schedule.num_frames; f++) {
+            for (int k = 0; k < schedule.frame_count[f]; k++) {
+                if (schedule.frame_tasks[f][k] != i) continue;
+                if (last_frame >= 0 && (f - last_frame) * schedule.minor_ms != periods[i]) failures++;
+                last_frame = f;
+                count++;
+            }
+        }
+        if (count != schedule.major_ms / periods[i]) {
+            printf("FALHA: %s liberada %d vezes (esperado %d)\n", names[i], count, schedule.major_ms / periods[i]);
+            failures++;
+        }
+    }
+
+    // No quadro 0 todas as tarefas são liberadas, na ordem da tabela
+    failures += (schedule.frame_count[0] != n);
+    for (int k = 0; k < schedule.frame_count[0]; k++) failures += (schedule.frame_tasks[0][k] != k);
+
+    // === 2. TESTE: Entradas Inválidas ===
+    printf("\n--- TESTE: ENTRADAS INVALIDAS ---\n");
+    int invalid_period[] = {10, 0};
+    int too_many_frames[] = {7, 11, 13, 17};   // hiperperíodo 17017 com quadro de 1
+    failures += (buildCyclicSchedule(invalid_period, 2, &schedule) != -1);
+    failures += (buildCyclicSchedule(too_many_frames, 4, &schedule) != -1);
+    printf("Periodo nulo e hiperperiodo longo demais rejeitados.\n");
+
+    if (failures == 0) {
+        printf("\nSUCESSO: tabela de quadros consistente com os periodos.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <math.h>
+#include "fleet.h"
+
+#define TEST_DT 0.03
+#define TEST_STEPS 667   // ~20 s de simulação, como no app_final
+
+int main() {
+    int status = 0;
+
+    // === 1. TESTE: Um robô segue o modelo de referência ===
+    printf("--- TESTE: RASTREAMENTO DE UM ROBO ---\n");
+    FleetState* single = createFleet(1);
+    for (int k = 0; k < TEST_STEPS; k++) {
+        fleetStep(single, 0, 1, k * TEST_DT, TEST_DT);
+    }
+    double ex = single->ymx[0] - single->y1[0];
+    double ey = single->ymy[0] - single->y2[0];
+    double tracking_error = sqrt(ex * ex + ey * ey);
+    printf("Erro de rastreamento apos %.1f s: %.6f m\n", TEST_STEPS * TEST_DT, tracking_error);
+    if (tracking_error < 0.05) {
+        printf("Resultado: o robo acompanha o modelo de referencia, como esperado.\n");
+    } else {
+        printf("FALHA: erro de rastreamento acima de 0.05 m.\n");
+        status = 1;
+    }
+
+    // === 2. TESTE: O particionamento em lotes não altera o resultado ===
+    printf("\n\n--- TESTE: LOTE UNICO vs. LOTES PARTICIONADOS ---\n");
+    int n = 1000;
+    FleetState* whole = createFleet(n);
+    FleetState* split = createFleet(n);
+    for (int k = 0; k < 100; k++) {
+        fleetStep(whole, 0, n, k * TEST_DT, TEST_DT);
+        fleetStep(split, 0, n / 3, k * TEST_DT, TEST_DT);
+        fleetStep(split, n / 3, n, k * TEST_DT, TEST_DT);
+    }
+    double max_diff = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = fabs(whole->xc[i] - split->xc[i]) + fabs(whole->yc[i] - split->yc[i]) + fabs(whole->theta[i] - split->theta[i]);
+        if (d > max_diff) max_diff = d;
+    }
+    printf("Maior diferenca de estado entre as execucoes (%d robos): %g\n", n, max_diff);
+    if (max_diff == 0.0) {
+        printf("Resultado: os lotes sao independentes, como esperado.\n\n\n");
+    } else {
+        printf("FALHA: o resultado depende do particionamento.\n\n\n");
+        status = 1;
+    }
+
+    // === 3. TESTE: Mais workers que robôs ===
+    printf("--- TESTE: WORKERS LIMITADOS AO NUMERO DE ROBOS ---\n");
+    FleetState* pair = createFleet(2);
+    FleetConfig config = {.workers = 4, .period_ms = 10, .duration_s = 0.1, .pin = 0};
+    FleetReport report;
+    int err = runFleet(pair, &config, &report);
+    printf("Workers pedidos: %d, usados: %d, ativacoes: %ld\n", config.workers, report.workers, report.activations);
+    if (err == 0 && report.workers == 2 && report.activations == 2 * 10) {
+        printf("Resultado: o relatorio traz o numero efetivo de workers, como esperado.\n\n\n");
+    } else {
+        printf("FALHA: o relatorio nao reflete os workers usados.\n\n\n");
+        status = 1;
+    }
+
+    freeFleet(single);
+    freeFleet(whole);
+    freeFleet(split);
+    freeFleet(pair);
+    return status;
+}
@@ -0,0 +1,502 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "matrixOperations.h"
+#include "batchedMatrix.h"
+#include "matrixIO.h"
+
+// Orçamento de trabalho por medição (operações de ponto flutuante aproximadas)
+#define WORK_BUDGET 40000000.0
+
+double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+Matrix* randomMatrix(int rows, int cols) {
+    Matrix* m = createMatrix(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            m->data[i][j] = (double)rand() / RAND_MAX - 0.5;
+        }
+    }
+    return m;
+}
+
+int iterationsFor(double flops_per_op) {
+    int it = (int)(WORK_BUDGET / flops_per_op);
+    return (it < 20) ? 20 : it;
+}
+
+void printRow(const char* op, int n, double composed_ns, double fused_ns) {
+    printf("%-22s %7d %14.1f %14.1f %9.1fx\n", op, n, composed_ns, fused_ns, composed_ns / fused_ns);
+}
+
+// x + dt * (A * u): multiplyMatrix + scalarMultiply + addMatrix vs. gemv
+void benchGemvAxpy(int rows, int cols, double* sink) {
+    Matrix* A = randomMatrix(rows, cols);
+    Matrix* u = randomMatrix(cols, 1);
+    Matrix* x = randomMatrix(rows, 1);
+    double dt = 1e-6;
+    int it = iterationsFor(2.0 * rows * cols + 3.0 * rows);
+
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        Matrix* Au = multiplyMatrix(A, u);
+        Matrix* term = scalarMultiply(Au, dt);
+        Matrix* next = addMatrix(x, term);
+        *sink += next->data[0][0];
+        freeMatrix(Au);
+        freeMatrix(term);
+        freeMatrix(next);
+    }
+    double composed = (now_ns() - t0) / it;
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        gemv(dt, A, u, 1.0, x);
+        *sink += x->data[0][0];
+    }
+    double fused = (now_ns() - t0) / it;
+
+    char label[32];
+    snprintf(label, sizeof(label), "x + dt*A*u (%dx%d)", rows, cols);
+    printRow(label, rows, composed, fused);
+
+    freeMatrix(A);
+    freeMatrix(u);
+    freeMatrix(x);
+}
+
+// y + alpha * x: scalarMultiply + addMatrix vs. axpy
+void benchAxpy(int n, double* sink) {
+    Matrix* x = randomMatrix(n, 1);
+    Matrix* y = randomMatrix(n, 1);
+    int it = iterationsFor(2.0 * n);
+
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        Matrix* ax = scalarMultiply(x, 1e-9);
+        Matrix* next = addMatrix(y, ax);
+        *sink += next->data[n - 1][0];
+        freeMatrix(ax);
+        freeMatrix(next);
+    }
+    double composed = (now_ns() - t0) / it;
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        axpy(1e-9, x, y);
+        *sink += y->data[n - 1][0];
+    }
+    double fused = (now_ns() - t0) / it;
+
+    printRow("axpy", n, composed, fused);
+    freeMatrix(x);
+    freeMatrix(y);
+}
+
+// x^T y: transposeMatrix + multiplyMatrix vs. dot
+void benchDot(int n, double* sink) {
+    Matrix* x = randomMatrix(n, 1);
+    Matrix* y = randomMatrix(n, 1);
+    int it = iterationsFor(2.0 * n);
+
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        Matrix* xT = transposeMatrix(x);
+        Matrix* p = multiplyMatrix(xT, y);
+        *sink += p->data[0][0];
+        freeMatrix(xT);
+        freeMatrix(p);
+    }
+    double composed = (now_ns() - t0) / it;
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        *sink += dot(x, y);
+    }
+    double fused = (now_ns() - t0) / it;
+
+    printRow("dot", n, composed, fused);
+    freeMatrix(x);
+    freeMatrix(y);
+}
+
+// alpha*a + beta*b: scalarMultiply x2 + addMatrix vs. scaledAdd
+void benchScaledAdd(int n, double* sink) {
+    Matrix* a = randomMatrix(n, n);
+    Matrix* b = randomMatrix(n, n);
+    Matrix* out = createMatrix(n, n);
+    int it = iterationsFor(3.0 * n * n);
+
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        Matrix* sa = scalarMultiply(a, 0.5);
+        Matrix* sb = scalarMultiply(b, 2.0);
+        Matrix* r = addMatrix(sa, sb);
+        *sink += r->data[n - 1][n - 1];
+        freeMatrix(sa);
+        freeMatrix(sb);
+        freeMatrix(r);
+    }
+    double composed = (now_ns() - t0) / it;
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        scaledAdd(0.5, a, 2.0, b, out);
+        *sink += out->data[n - 1][n - 1];
+    }
+    double fused = (now_ns() - t0) / it;
+
+    printRow("scaledAdd (n x n)", n, composed, fused);
+    freeMatrix(a);
+    freeMatrix(b);
+    freeMatrix(out);
+}
+
+// Problemas K x K por segundo: inverseMatrix um a um vs. batchInverse/batchSolve
+void benchBatched(int K, int count, double* sink) {
+    double* A = malloc(sizeof(double) * K * K * count);
+    double* Ainv = malloc(sizeof(double) * K * K * count);
+    double* b = malloc(sizeof(double) * K * count);
+    double* x = malloc(sizeof(double) * K * count);
+    for (int e = 0; e < K * K; e++) {
+        for (int i = 0; i < count; i++) {
+            double value = (double)rand() / RAND_MAX - 0.5;
+            A[e * count + i] = (e % (K + 1) == 0) ? value + K : value;   // diagonal reforçada
+        }
+    }
+    for (int e = 0; e < K * count; e++) b[e] = (double)rand() / RAND_MAX - 0.5;
+
+    int (*inverse)(int, const double*, double*) =
+        (K == 2) ? batchInverse2x2 : (K == 3) ? batchInverse3x3 : batchInverse4x4;
+    int (*solve)(int, const double*, const double*, double*) =
+        (K == 2) ? batchSolve2x2 : (K == 3) ? batchSolve3x3 : batchSolve4x4;
+
+    // Referência escalar: uma Matrix por problema, como em linearization_step antes dos lotes
+    Matrix* m = createMatrix(K, K);
+    int scalar_problems = 4096;
+    double t0 = now_ns();
+    for (int p = 0; p < scalar_problems; p++) {
+        int i = p % count;
+        for (int e = 0; e < K * K; e++) m->data[e / K][e % K] = A[e * count + i];
+        Matrix* inv = inverseMatrix(m);
+        *sink += inv->data[0][0];
+        freeMatrix(inv);
+    }
+    double scalar_rate = scalar_problems / ((now_ns() - t0) * 1e-9);
+    freeMatrix(m);
+
+    int reps = iterationsFor(10.0 * K * K * K * count);
+    t0 = now_ns();
+    for (int r = 0; r < reps; r++) {
+        inverse(count, A, Ainv);
+        *sink += Ainv[count - 1];
+    }
+    double inverse_rate = (double)reps * count / ((now_ns() - t0) * 1e-9);
+
+    t0 = now_ns();
+    for (int r = 0; r < reps; r++) {
+        solve(count, A, b, x);
+        *sink += x[count - 1];
+    }
+    double solve_rate = (double)reps * count / ((now_ns() - t0) * 1e-9);
+
+    printf("%dx%d %9d %16.3g %16.3g %16.3g %8.1fx\n",
+           K, K, count, scalar_rate, inverse_rate, solve_rate, inverse_rate / scalar_rate);
+
+    free(A);
+    free(Ainv);
+    free(b);
+    free(x);
+}
+
+// Matriz com diagonal reforçada (bem condicionada, LU sem pivôs pequenos)
+Matrix* diagonallyDominant(int n) {
+    Matrix* A = randomMatrix(n, n);
+    for (int i = 0; i < n; i++) A->data[i][i] += n / 4.0;
+    return A;
+}
+
+MatrixF* toFloat(const Matrix* m) {
+    MatrixF* f = createMatrixF(m->rows, m->cols);
+    convertMatrixToFloat(m, f);
+    return f;
+}
+
+// Diferença relativa (norma infinito) entre o resultado em float e o de referência em double
+double relativeError(const MatrixF* approx, const Matrix* reference) {
+    Matrix* widened = createMatrix(approx->rows, approx->cols);
+    convertMatrixToDouble(approx, widened);
+    scaledAdd(1.0, widened, -1.0, reference, widened);
+    double error = normInf(widened) / normInf(reference);
+    freeMatrix(widened);
+    return error;
+}
+
+/*
+ * Mesma operação em double e em float (ns por chamada) e erro relativo do
+ * resultado em float. op: "axpy", "dot", "scaledAdd", "gemv" (n x n) ou "lu"
+ * (fatoração e solução n x n, incluindo a cópia de A).
+ */
+void benchPrecision(const char* op, int n, double* sink) {
+    int square = (strcmp(op, "gemv") == 0 || strcmp(op, "lu") == 0);
+    Matrix* A = diagonallyDominant(square ? n : 1);
+    Matrix* x = randomMatrix(n, 1);
+    Matrix* y = randomMatrix(n, 1);
+    Matrix* out = createMatrix(square ? n : n, square ? n : 1);
+    MatrixF* Af = toFloat(A);
+    MatrixF* xf = toFloat(x);
+    MatrixF* yf = toFloat(y);
+    MatrixF* outf = createMatrixF(out->rows, out->cols);
+    int* pivots = malloc(sizeof(int) * n);
+    double flops = square ? ((strcmp(op, "lu") == 0) ? 2.0 * n * n * n / 3.0 : 2.0 * n * n) : 2.0 * n;
+    int it = iterationsFor(flops);
+
+    // Referência em double (também aquece os caches)
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        if (strcmp(op, "axpy") == 0) axpy(1e-9, x, y);
+        else if (strcmp(op, "dot") == 0) *sink += dot(x, y);
+        else if (strcmp(op, "scaledAdd") == 0) scaledAdd(0.5, x, 0.25, y, y);
+        else if (strcmp(op, "gemv") == 0) gemv(1.0, A, x, 0.0, y);
+        else {
+            scaledAdd(1.0, A, 0.0, A, out);
+            luFactor(out, pivots);
+            luSolve(out, pivots, x, y);
+        }
+        *sink += y->data[n - 1][0];
+    }
+    double double_ns = (now_ns() - t0) / it;
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        if (strcmp(op, "axpy") == 0) axpyF(1e-9f, xf, yf);
+        else if (strcmp(op, "dot") == 0) *sink += dotF(xf, yf);
+        else if (strcmp(op, "scaledAdd") == 0) scaledAddF(0.5f, xf, 0.25f, yf, yf);
+        else if (strcmp(op, "gemv") == 0) gemvF(1.0f, Af, xf, 0.0f, yf);
+        else {
+            scaledAddF(1.0f, Af, 0.0f, Af, outf);
+            luFactorF(outf, pivots);
+            luSolveF(outf, pivots, xf, yf);
+        }
+        *sink += yf->data[n - 1][0];
+    }
+    double float_ns = (now_ns() - t0) / it;
+
+    // Erro: uma aplicação a partir das mesmas entradas nas duas precisões
+    Matrix* y0 = randomMatrix(n, 1);
+    MatrixF* y0f = toFloat(y0);
+    double error;
+    if (strcmp(op, "dot") == 0) {
+        double reference = dot(x, y0);
+        error = fabs(dotF(xf, y0f) - reference) / fabs(reference);
+    } else {
+        if (strcmp(op, "axpy") == 0) { axpy(0.5, x, y0); axpyF(0.5f, xf, y0f); }
+        else if (strcmp(op, "scaledAdd") == 0) { scaledAdd(0.5, x, 0.25, y0, y0); scaledAddF(0.5f, xf, 0.25f, y0f, y0f); }
+        else if (strcmp(op, "gemv") == 0) { gemv(1.0, A, x, 0.0, y0); gemvF(1.0f, Af, xf, 0.0f, y0f); }
+        else {
+            scaledAdd(1.0, A, 0.0, A, out);
+            luFactor(out, pivots);
+            luSolve(out, pivots, x, y0);
+            scaledAddF(1.0f, Af, 0.0f, Af, outf);
+            luFactorF(outf, pivots);
+            luSolveF(outf, pivots, xf, y0f);
+        }
+        error = relativeError(y0f, y0);
+    }
+
+    printf("%-10s %7d %12.1f %12.1f %8.2fx %12.2e\n", op, n, double_ns, float_ns, double_ns / float_ns, error);
+
+    freeMatrix(A);
+    freeMatrix(x);
+    freeMatrix(y);
+    freeMatrix(out);
+    freeMatrix(y0);
+    freeMatrixF(Af);
+    freeMatrixF(xf);
+    freeMatrixF(yf);
+    freeMatrixF(outf);
+    freeMatrixF(y0f);
+    free(pivots);
+}
+
+// A x = b: LU em double, LU em float e LU em float com refinamento em double (us por solução)
+void benchMixedSolve(int n, double* sink) {
+    Matrix* A = diagonallyDominant(n);
+    Matrix* x_true = randomMatrix(n, 1);
+    Matrix* b = createMatrix(n, 1);
+    gemv(1.0, A, x_true, 0.0, b);
+    Matrix* LU = createMatrix(n, n);
+    Matrix* x = createMatrix(n, 1);
+    MatrixF* LUf = createMatrixF(n, n);
+    MatrixF* xf = createMatrixF(n, 1);
+    int* pivots = malloc(sizeof(int) * n);
+    int it = iterationsFor(2.0 * n * n * n / 3.0);
+
+    double t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        scaledAdd(1.0, A, 0.0, A, LU);
+        luFactor(LU, pivots);
+        luSolve(LU, pivots, b, x);
+    }
+    double double_us = (now_ns() - t0) / it / 1e3;
+    double double_error = 0.0;
+    for (int i = 0; i < n; i++) double_error = fmax(double_error, fabs(x->data[i][0] - x_true->data[i][0]));
+
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) {
+        convertMatrixToFloat(A, LUf);
+        convertMatrixToFloat(b, xf);
+        luFactorF(LUf, pivots);
+        luSolveF(LUf, pivots, xf, xf);
+    }
+    double float_us = (now_ns() - t0) / it / 1e3;
+    double float_error = relativeError(xf, x_true);
+
+    int iterations = 0;
+    t0 = now_ns();
+    for (int k = 0; k < it; k++) iterations = mixedPrecisionSolve(A, b, x, 10, 1e-15);
+    double mixed_us = (now_ns() - t0) / it / 1e3;
+    double mixed_error = 0.0;
+    for (int i = 0; i < n; i++) mixed_error = fmax(mixed_error, fabs(x->data[i][0] - x_true->data[i][0]));
+    *sink += x->data[n - 1][0] + xf->data[n - 1][0];
+
+    double scale = normInf(x_true);
+    printf("%5d %11.1f %10.2e %11.1f %10.2e %11.1f %10.2e %6d\n", n, double_us, double_error / scale,
+           float_us, float_error, mixed_us, mixed_error / scale, iterations);
+
+    freeMatrix(A);
+    freeMatrix(x_true);
+    freeMatrix(b);
+    freeMatrix(LU);
+    freeMatrix(x);
+    freeMatrixF(LUf);
+    freeMatrixF(xf);
+    free(pivots);
+}
+
+// Tempo (ms) para ler/gravar uma matriz rows x cols: fscanf vs. importMatrixCSV e arquivo binário mapeado.
+// digits é a precisão do CSV (17 garante ida e volta exata, mas cai no caminho lento de strtod).
+void benchIO(int rows, int cols, int digits, double* sink) {
+    const char* csv_path = "/tmp/bench_matriz.csv";
+    const char* bin_path = "/tmp/bench_matriz.rtmx";
+    Matrix* m = randomMatrix(rows, cols);
+
+    FILE* file = fopen(csv_path, "w");
+    if (file == NULL) {
+        freeMatrix(m);
+        return;
+    }
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) fprintf(file, "%.*g%c", digits, m->data[i][j], (j + 1 < cols) ? ',' : '\n');
+    }
+    fclose(file);
+
+    // Referência: um fscanf por elemento, como scanMatrix
+    double t0 = now_ns();
+    file = fopen(csv_path, "r");
+    Matrix* scanned = createMatrix(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (fscanf(file, "%lf,", &scanned->data[i][j]) != 1) break;
+        }
+    }
+    fclose(file);
+    double scanf_ms = (now_ns() - t0) / 1e6;
+    *sink += scanned->data[rows - 1][cols - 1];
+    freeMatrix(scanned);
+
+    t0 = now_ns();
+    Matrix* imported = importMatrixCSV(csv_path);
+    double import_ms = (now_ns() - t0) / 1e6;
+    if (imported) *sink += imported->data[rows - 1][cols - 1];
+    freeMatrix(imported);
+
+    t0 = now_ns();
+    saveMatrixBinary(m, bin_path);
+    double save_ms = (now_ns() - t0) / 1e6;
+
+    t0 = now_ns();
+    MappedMatrix* mapped = mapMatrixBinary(bin_path, 0);
+    double map_ms = (now_ns() - t0) / 1e6;
+    unmapMatrixBinary(mapped);
+
+    t0 = now_ns();
+    mapped = mapMatrixBinary(bin_path, MATRIX_IO_VERIFY);
+    double verify_ms = (now_ns() - t0) / 1e6;
+    if (mapped) *sink += mapped->matrix.data[rows - 1][cols - 1];
+    unmapMatrixBinary(mapped);
+
+    printf("%5dx%-5d %7d %10.3f %10.3f %8.1fx %10.3f %10.3f %12.3f\n",
+           rows, cols, digits, scanf_ms, import_ms, scanf_ms / import_ms, save_ms, map_ms, verify_ms);
+
+    freeMatrix(m);
+    remove(csv_path);
+    remove(bin_path);
+}
+
+int main() {
+    double sink = 0.0;
+    srand(42);
+
+    printf("--- BENCHMARK: OPERACOES COMPOSTAS vs. KERNELS FUNDIDOS (ns por operacao) ---\n");
+    printf("%-22s %7s %14s %14s %10s\n", "Operacao", "n", "Composto", "Fundido", "Ganho");
+
+    benchGemvAxpy(3, 2, &sink);   // atualização do robô
+    benchGemvAxpy(16, 16, &sink);
+    benchGemvAxpy(64, 64, &sink);
+    benchGemvAxpy(256, 256, &sink);
+
+    benchAxpy(3, &sink);
+    benchAxpy(1024, &sink);
+    benchAxpy(65536, &sink);
+
+    benchDot(3, &sink);
+    benchDot(1024, &sink);
+    benchDot(65536, &sink);
+
+    benchScaledAdd(16, &sink);
+    benchScaledAdd(256, &sink);
+
+    printf("\n--- BENCHMARK: LOTES DE MATRIZES PEQUENAS (problemas por segundo) ---\n");
+    printf("%-3s %9s %16s %16s %16s %9s\n", "K", "Lote", "inverseMatrix", "batchInverse", "batchSolve", "Ganho");
+    for (int K = 2; K <= 4; K++) {
+        benchBatched(K, 1, &sink);      // uso em linearization_step
+        benchBatched(K, 1024, &sink);
+        benchBatched(K, 65536, &sink);
+    }
+
+    printf("\n--- BENCHMARK: PRECISAO DUPLA vs. SIMPLES (ns por chamada) ---\n");
+    printf("%-10s %7s %12s %12s %9s %12s\n", "Operacao", "n", "double", "float", "Ganho", "Erro rel.");
+    benchPrecision("axpy", 65536, &sink);
+    benchPrecision("dot", 65536, &sink);
+    benchPrecision("scaledAdd", 65536, &sink);
+    benchPrecision("axpy", 1 << 22, &sink);   // limitado pela memória
+    benchPrecision("gemv", 256, &sink);
+    benchPrecision("gemv", 2048, &sink);
+    benchPrecision("lu", 64, &sink);
+    benchPrecision("lu", 512, &sink);
+
+    printf("\n--- BENCHMARK: SOLUCAO DE SISTEMAS (us por solucao, erro relativo) ---\n");
+    printf("%5s %11s %10s %11s %10s %11s %10s %6s\n", "n", "LU double", "erro", "LU float", "erro",
+           "Mista", "erro", "Refin.");
+    benchMixedSolve(64, &sink);
+    benchMixedSolve(256, &sink);
+    benchMixedSolve(1024, &sink);
+
+    printf("\n--- BENCHMARK: E/S DE MATRIZES (ms) ---\n");
+    printf("%-11s %7s %10s %10s %9s %10s %10s %12s\n", "Formato", "Dígitos", "fscanf", "CSV lote", "Ganho", "Gravar bin",
+           "Mapear", "Mapear+soma");
+    benchIO(100, 100, 9, &sink);
+    benchIO(1000, 100, 9, &sink);
+    benchIO(2000, 1000, 9, &sink);
+    benchIO(2000, 1000, 17, &sink);
+
+    printf("\n(checksum: %g)\n\n", sink);
+    return 0;
+}
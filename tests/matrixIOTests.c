@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "matrixIO.h"
+
+// Arquivo temporário com o conteúdo dado; retorna 0 em caso de sucesso
+int write_temp(char* path, const char* content) {
+    strcpy(path, "/tmp/teste_matriz_es_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return -1;
+    size_t len = strlen(content);
+    int ok = (write(fd, content, len) == (ssize_t)len);
+    close(fd);
+    return ok ? 0 : -1;
+}
+
+// Lê o cabeçalho de um arquivo gravado, altera com `patch` e grava de volta
+int patch_header(const char* path, void (*patch)(MatrixFileHeader*)) {
+    FILE* file = fopen(path, "r+b");
+    if (file == NULL) return -1;
+    MatrixFileHeader header;
+    int ok = (fread(&header, sizeof(header), 1, file) == 1);
+    patch(&header);
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+    return (fclose(file) == 0 && ok) ? 0 : -1;
+}
+
+// Linhas com preenchimento: stride maior que cols (os bytes continuam os mesmos)
+void pad_rows(MatrixFileHeader* h) { h->cols -= 1; h->stride = h->cols + 1; }
+// rows * cols * 8 estoura 64 bits e rows não cabe em int
+void huge_rows(MatrixFileHeader* h) { h->rows = UINT32_MAX; h->cols = UINT32_MAX; h->stride = UINT32_MAX; }
+
+int same_matrix(const Matrix* a, const Matrix* b) {
+    if (a->rows != b->rows || a->cols != b->cols) return 0;
+    for (int i = 0; i < a->rows; i++) {
+        if (memcmp(a->data[i], b->data[i], a->cols * sizeof(double)) != 0) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    int failures = 0;
+    char path[64];
+
+    // === 1. TESTE: Binário (gravar e mapear) ===
+    printf("--- TESTE: FORMATO BINARIO ---\n");
+    Matrix* m = createMatrix(3, 5);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) m->data[i][j] = (i + 1) * 0.1 + j / 3.0;   // valores sem representação exata
+    }
+    strcpy(path, "/tmp/teste_matriz_es_XXXXXX");
+    close(mkstemp(path));
+    failures += saveMatrixBinary(m, path) != 0;
+
+    MappedMatrix* mapped = mapMatrixBinary(path, MATRIX_IO_VERIFY);
+    if (mapped == NULL) {
+        printf("FALHA: arquivo gravado nao pode ser mapeado.\n");
+        return 1;
+    }
+    const MatrixFileHeader* header = (const MatrixFileHeader*)mapped->map;
+    printf("%ux%u, stride %llu, dados em %llu, soma 0x%016llx\n", header->rows, header->cols,
+           (unsigned long long)header->stride, (unsigned long long)header->data_offset,
+           (unsigned long long)header->checksum);
+    failures += !same_matrix(m, &mapped->matrix);                                 // bits idênticos
+    failures += header->data_offset % MATRIX_FILE_ALIGN != 0;
+    failures += (char*)mapped->matrix.data[0] != (char*)mapped->map + header->data_offset;  // sem cópia
+
+    // A visão é privada: alterá-la não modifica o arquivo
+    mapped->matrix.data[1][2] = 42.0;
+    unmapMatrixBinary(mapped);
+    mapped = mapMatrixBinary(path, MATRIX_IO_VERIFY);
+    failures += (mapped == NULL) || !same_matrix(m, &mapped->matrix);
+    unmapMatrixBinary(mapped);
+
+    // Um byte alterado nos dados é detectado pela soma de verificação
+    FILE* file = fopen(path, "r+b");
+    fseek(file, MATRIX_FILE_ALIGN + 8, SEEK_SET);
+    fputc(0x7f, file);
+    fclose(file);
+    failures += mapMatrixBinary(path, MATRIX_IO_VERIFY) != NULL;
+    mapped = mapMatrixBinary(path, 0);   // sem verificação o arquivo ainda abre
+    failures += mapped == NULL;
+    unmapMatrixBinary(mapped);
+
+    // Linhas fora de ordem na memória: a soma gravada linha a linha confere com a do mapeamento
+    double* scattered_rows[3] = {m->data[2], m->data[0], m->data[1]};
+    Matrix scattered = {3, 5, scattered_rows};
+    failures += saveMatrixBinary(&scattered, path) != 0;
+    mapped = mapMatrixBinary(path, MATRIX_IO_VERIFY);
+    failures += (mapped == NULL) || !same_matrix(&scattered, &mapped->matrix);
+    unmapMatrixBinary(mapped);
+
+    // Cabeçalhos com linhas não contíguas ou dimensões que estouram são recusados
+    failures += saveMatrixBinary(m, path) != 0;
+    failures += (patch_header(path, pad_rows) != 0) || (mapMatrixBinary(path, 0) != NULL);
+    failures += saveMatrixBinary(m, path) != 0;
+    failures += (patch_header(path, huge_rows) != 0) || (mapMatrixBinary(path, 0) != NULL);
+    remove(path);
+
+    // Arquivo que não é uma matriz
+    failures += write_temp(path, "nao sou uma matriz, mas tenho mais de sessenta e quatro bytes de texto aqui") != 0;
+    failures += mapMatrixBinary(path, 0) != NULL;
+    remove(path);
+
+    // === 2. TESTE: Importação de CSV ===
+    printf("\n--- TESTE: IMPORTACAO DE CSV ---\n");
+    failures += write_temp(path, "1.5, -2, 3e2\r\n\n4;5.25;-6\n7\t8\t9e-1\n") != 0;
+    Matrix* csv = importMatrixCSV(path);
+    remove(path);
+    if (csv == NULL) {
+        printf("FALHA: CSV valido recusado.\n");
+        return 1;
+    }
+    displayMatrix(csv);
+    double expected[3][3] = {{1.5, -2, 300}, {4, 5.25, -6}, {7, 8, 0.9}};
+    failures += csv->rows != 3 || csv->cols != 3;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) failures += csv->data[i][j] != expected[i][j];
+    }
+    freeMatrix(csv);
+
+    // Linhas com número de colunas diferente e campos não numéricos são recusados
+    failures += write_temp(path, "1,2,3\n4,5\n") != 0;
+    failures += importMatrixCSV(path) != NULL;
+    remove(path);
+    failures += write_temp(path, "1,2x,3\n") != 0;
+    failures += importMatrixCSV(path) != NULL;
+    remove(path);
+
+    // Hexadecimal vai inteiro para strtod (e não vira 0 seguido de "x10")
+    failures += write_temp(path, "0x10,-0X1p-2,+0x1A\n") != 0;
+    csv = importMatrixCSV(path);
+    remove(path);
+    failures += (csv == NULL) || csv->data[0][0] != 16.0 || csv->data[0][1] != -0.25 || csv->data[0][2] != 26.0;
+    freeMatrix(csv);
+
+    // Mesmo resultado, bit a bit, que strtod para qualquer número de dígitos e expoente
+    int count = 0;
+    strcpy(path, "/tmp/teste_matriz_es_XXXXXX");
+    file = fdopen(mkstemp(path), "w");
+    srand(7);
+    for (int i = 0; i < 1000; i++) {
+        double v = ((double)rand() / RAND_MAX - 0.5) * pow(10.0, rand() % 60 - 30);
+        fprintf(file, "%.*g%c", 1 + i % 17, v, (i % 10 == 9) ? '\n' : ',');
+    }
+    fclose(file);
+    csv = importMatrixCSV(path);
+    file = fopen(path, "r");
+    char field[64];
+    for (int i = 0; csv != NULL && i < 1000; i++) {
+        int c, n = 0;
+        while ((c = fgetc(file)) != ',' && c != '\n') field[n++] = (char)c;
+        field[n] = '\0';
+        double reference = strtod(field, NULL);
+        count += memcmp(&reference, &csv->data[i / 10][i % 10], sizeof(double)) != 0;
+    }
+    fclose(file);
+    remove(path);
+    printf("Campos divergentes de strtod: %d de 1000\n", count);
+    failures += (csv == NULL) || count != 0;
+    freeMatrix(csv);
+
+    freeMatrix(m);
+
+    if (failures == 0) {
+        printf("\nSUCESSO: E/S de matrizes consistente.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
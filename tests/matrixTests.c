@@ -1,7 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include "matrixOperations.h" 
 
+// Maior diferença absoluta entre duas matrizes de mesmo formato
+double maxDifference(Matrix* a, Matrix* b) {
+    Matrix* diff = subMatrix(a, b);
+    double d = normInf(diff);
+    freeMatrix(diff);
+    return d;
+}
+
 int main() {
     // Matrizes de teste
     Matrix* M1 = createMatrix(2, 3);
@@ -93,6 +102,179 @@ int main() {
         printf("\nResultado: A matriz nao e invertivel, como esperado.\n\n\n");
     }
 
+    // === 6. TESTE: Kernels Fundidos ===
+    printf("--- TESTE: KERNELS FUNDIDOS (SEM ALOCACAO) ---\n");
+    int failures = 0;
+
+    // x + dt * (B * u), como na atualização do robô
+    Matrix* B = createMatrix(3, 2);
+    B->data[0][0] = 0.5; B->data[1][0] = 0.8; B->data[2][1] = 1.0;
+    Matrix* u = createMatrix(2, 1);
+    u->data[0][0] = 1.5; u->data[1][0] = -0.7;
+    Matrix* x = createMatrix(3, 1);
+    x->data[0][0] = 1.0; x->data[1][0] = 2.0; x->data[2][0] = 3.0;
+    double dt = 0.03;
+
+    Matrix* Bu = multiplyMatrix(B, u);
+    Matrix* term = scalarMultiply(Bu, dt);
+    Matrix* composed = addMatrix(x, term);
+    gemv(dt, B, u, 1.0, x);
+    printf("\ngemv: x + dt*(B*u):\n");
+    displayMatrix(x);
+    double d_gemv = maxDifference(x, composed);
+    printf("Diferenca para multiplyMatrix/scalarMultiply/addMatrix: %g\n", d_gemv);
+    failures += (d_gemv > 1e-12);
+
+    // axpy e scaledAdd contra as operações compostas
+    Matrix* axpy_res = createMatrix(2, 2);
+    scaledAdd(1.0, M4, 0.0, M4, axpy_res);
+    axpy(2.5, M3, axpy_res);
+    Matrix* axpy_ref = addMatrix(M4, scalar_res);
+    printf("\naxpy (M4 + 2.5 * M3):\n");
+    displayMatrix(axpy_res);
+    double d_axpy = maxDifference(axpy_res, axpy_ref);
+    printf("Diferenca: %g\n", d_axpy);
+    failures += (d_axpy > 1e-12);
+
+    Matrix* scaled_res = createMatrix(2, 2);
+    scaledAdd(1.0, M3, -1.0, M4, scaled_res);
+    printf("\nscaledAdd (M3 - M4):\n");
+    displayMatrix(scaled_res);
+    double d_scaled = maxDifference(scaled_res, sub_res);
+    printf("Diferenca: %g\n", d_scaled);
+    failures += (d_scaled > 1e-12);
+
+    // ger: A + x * y^T
+    Matrix* ger_res = createMatrix(3, 2);
+    scaledAdd(1.0, B, 0.0, B, ger_res);
+    ger(1.0, x, u, ger_res);
+    Matrix* uT = transposeMatrix(u);
+    Matrix* outer = multiplyMatrix(x, uT);
+    Matrix* ger_ref = addMatrix(B, outer);
+    printf("\nger (B + x * u^T):\n");
+    displayMatrix(ger_res);
+    double d_ger = maxDifference(ger_res, ger_ref);
+    printf("Diferenca: %g\n", d_ger);
+    failures += (d_ger > 1e-12);
+
+    // dot e normas em um vetor conhecido: [3, -4, 0]
+    Matrix* v = createMatrix(3, 1);
+    v->data[0][0] = 3.0; v->data[1][0] = -4.0;
+    printf("\ndot(v, v) = %.2f (esperado 25.00)\n", dot(v, v));
+    printf("norm1 = %.2f, norm2 = %.2f, normInf = %.2f (esperado 7.00, 5.00, 4.00)\n", norm1(v), norm2(v), normInf(v));
+    failures += fabs(dot(v, v) - 25.0) > 1e-12 || fabs(norm1(v) - 7.0) > 1e-12;
+    failures += fabs(norm2(v) - 5.0) > 1e-12 || fabs(normInf(v) - 4.0) > 1e-12;
+
+    if (failures == 0) {
+        printf("\nResultado: os kernels fundidos coincidem com as operacoes compostas.\n\n\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n\n\n", failures);
+    }
+
+    // === 7. TESTE: Precisão Simples, LU e Precisão Mista ===
+    printf("--- TESTE: PRECISAO SIMPLES, LU E PRECISAO MISTA ---\n");
+    int failures_before = failures;
+
+    // Mesmas operações em float: diferença na ordem de eps_float
+    MatrixF* Bf = createMatrixF(3, 2);
+    MatrixF* uf = createMatrixF(2, 1);
+    MatrixF* xf = createMatrixF(3, 1);
+    convertMatrixToFloat(B, Bf);
+    convertMatrixToFloat(u, uf);
+    xf->data[0][0] = 1.0f; xf->data[1][0] = 2.0f; xf->data[2][0] = 3.0f;
+    gemvF((float)dt, Bf, uf, 1.0f, xf);
+    Matrix* x_from_float = createMatrix(3, 1);
+    convertMatrixToDouble(xf, x_from_float);
+    double d_float = maxDifference(x_from_float, composed);
+    printf("\ngemvF: diferenca para o resultado em double: %g\n", d_float);
+    failures += (d_float > 1e-6);
+    MatrixF* vf = createMatrixF(3, 1);
+    convertMatrixToFloat(v, vf);
+    printf("dotF = %.2f, norm2F = %.2f\n", dotF(vf, vf), norm2F(vf));
+    failures += fabsf(dotF(vf, vf) - 25.0f) > 1e-6f || fabsf(norm2F(vf) - 5.0f) > 1e-6f;
+
+    // LU com pivoteamento: M5 x = [1, 0, 1] tem solução [1, 1, 1]
+    Matrix* LU = createMatrix(3, 3);
+    scaledAdd(1.0, M5_invertible, 0.0, M5_invertible, LU);
+    int pivots[3];
+    Matrix* rhs = createMatrix(3, 1);
+    rhs->data[0][0] = 1.0; rhs->data[2][0] = 1.0;
+    Matrix* sol = createMatrix(3, 1);
+    failures += luFactor(LU, pivots) != 0 || luSolve(LU, pivots, rhs, sol) != 0;
+    printf("\nluSolve (M5 x = [1 0 1]):\n");
+    displayMatrix(sol);
+    for (int i = 0; i < 3; i++) failures += fabs(sol->data[i][0] - 1.0) > 1e-12;
+    Matrix* singular_copy = createMatrix(2, 2);
+    scaledAdd(1.0, M6_singular, 0.0, M6_singular, singular_copy);
+    failures += luFactor(singular_copy, pivots) != -1;
+
+    // Precisão mista em um sistema 50x50 bem condicionado: erro de double com fatoração em float
+    int n = 50;
+    Matrix* A = createMatrix(n, n);
+    Matrix* x_true = createMatrix(n, 1);
+    Matrix* b = createMatrix(n, 1);
+    Matrix* x_mixed = createMatrix(n, 1);
+    srand(3);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) A->data[i][j] = (double)rand() / RAND_MAX - 0.5 + (i == j ? n / 4.0 : 0.0);
+        x_true->data[i][0] = (double)rand() / RAND_MAX - 0.5;
+    }
+    gemv(1.0, A, x_true, 0.0, b);
+    int iterations = mixedPrecisionSolve(A, b, x_mixed, 10, 1e-15);
+    double mixed_error = maxDifference(x_mixed, x_true) / normInf(x_true);
+    printf("\nmixedPrecisionSolve (50x50): %d refinamentos, erro relativo %.2e\n", iterations, mixed_error);
+    failures += iterations < 1 || mixed_error > 1e-13;
+
+    // Hilbert 12x12 (cond ~ 1e16): a fatoração em float não serve e o refinamento deve desistir
+    Matrix* H = createMatrix(12, 12);
+    Matrix* hb = createMatrix(12, 1);
+    Matrix* hx = createMatrix(12, 1);
+    for (int i = 0; i < 12; i++) {
+        for (int j = 0; j < 12; j++) H->data[i][j] = 1.0 / (i + j + 1);
+        hb->data[i][0] = 1.0;
+    }
+    int hilbert_iterations = mixedPrecisionSolve(H, hb, hx, 10, 1e-15);
+    printf("mixedPrecisionSolve (Hilbert 12x12): %d (esperado -1)\n", hilbert_iterations);
+    failures += hilbert_iterations != -1;
+
+    if (failures == failures_before) {
+        printf("\nResultado: variantes float, LU e precisao mista consistentes.\n\n\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n\n\n", failures - failures_before);
+    }
+
+    freeMatrixF(Bf);
+    freeMatrixF(uf);
+    freeMatrixF(xf);
+    freeMatrixF(vf);
+    freeMatrix(x_from_float);
+    freeMatrix(LU);
+    freeMatrix(rhs);
+    freeMatrix(sol);
+    freeMatrix(singular_copy);
+    freeMatrix(A);
+    freeMatrix(x_true);
+    freeMatrix(b);
+    freeMatrix(x_mixed);
+    freeMatrix(H);
+    freeMatrix(hb);
+    freeMatrix(hx);
+
+    freeMatrix(B);
+    freeMatrix(u);
+    freeMatrix(x);
+    freeMatrix(Bu);
+    freeMatrix(term);
+    freeMatrix(composed);
+    freeMatrix(axpy_res);
+    freeMatrix(axpy_ref);
+    freeMatrix(scaled_res);
+    freeMatrix(ger_res);
+    freeMatrix(uT);
+    freeMatrix(outer);
+    freeMatrix(ger_ref);
+    freeMatrix(v);
+
     freeMatrix(M1);
     freeMatrix(M2);
     freeMatrix(M3);
@@ -109,5 +291,5 @@ int main() {
     freeMatrix(identity_res);
     freeMatrix(inv_singular_res);
 
-    return 0;
+    return failures ? 1 : 0;
 }
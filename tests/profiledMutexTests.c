@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "profiledMutex.h"
+
+#define HOLD_US 5000
+
+ProfiledMutex lock;
+pthread_barrier_t barrier;
+
+// Tarefa 0: adquire a trava e a segura por HOLD_US
+void* holder_thread(void* arg) {
+    (void)arg;
+    profiledMutexSetTask(0);
+    profiledLock(&lock);
+    pthread_barrier_wait(&barrier);
+    usleep(HOLD_US);
+    profiledUnlock(&lock);
+    return NULL;
+}
+
+// Tarefa 1: tenta adquirir enquanto a tarefa 0 segura a trava
+void* waiter_thread(void* arg) {
+    (void)arg;
+    profiledMutexSetTask(1);
+    pthread_barrier_wait(&barrier);
+    profiledLock(&lock);
+    profiledUnlock(&lock);
+    return NULL;
+}
+
+int main() {
+    int failures = 0;
+
+    printf("--- TESTE: CONTENCAO ENTRE DUAS TAREFAS ---\n");
+    if (profiledMutexInit(&lock, "teste") != 0) {
+        printf("FALHA: PTHREAD_PRIO_INHERIT indisponivel.\n");
+        return 1;
+    }
+    pthread_barrier_init(&barrier, NULL, 2);
+
+    pthread_t a, b;
+    pthread_create(&a, NULL, holder_thread, NULL);
+    pthread_create(&b, NULL, waiter_thread, NULL);
+    pthread_join(a, NULL);
+    pthread_join(b, NULL);
+
+    // Aquisições sem contenção (mesma thread, id de tarefa indefinido)
+    profiledMutexSetTask(-1);
+    for (int i = 0; i < 10; i++) {
+        profiledLock(&lock);
+        profiledUnlock(&lock);
+    }
+
+    printf("Aquisicoes: %ld | Contencoes: %ld\n", lock.acquisitions, lock.contended);
+    printf("Tarefa 1: espera maxima %.3f ms | Tarefa 0: posse maxima %.3f ms\n",
+           lock.tasks[1].max_wait_ns / 1e6, lock.tasks[0].max_hold_ns / 1e6);
+    printf("Posse p50 <= %.1f us | p99 <= %.1f us\n",
+           lockHistogramQuantile(lock.hold_hist, 0.5) / 1e3, lockHistogramQuantile(lock.hold_hist, 0.99) / 1e3);
+
+    failures += (lock.acquisitions != 12) || (lock.contended != 1);
+    failures += (lock.tasks[0].acquisitions != 1) || (lock.tasks[0].contended != 0);
+    failures += (lock.tasks[1].acquisitions != 1) || (lock.tasks[1].contended != 1);
+    failures += (lock.tasks[1].max_wait_ns < HOLD_US * 500ULL);    // pelo menos metade da posse
+    failures += (lock.tasks[0].max_hold_ns < HOLD_US * 1000ULL);
+    failures += (lock.max_hold_ns != lock.tasks[0].max_hold_ns);
+    failures += (lockHistogramQuantile(lock.hold_hist, 1.0) < HOLD_US * 1000ULL);  // balde da posse longa
+    failures += (lockHistogramQuantile(lock.hold_hist, 0.5) >= HOLD_US * 1000ULL); // maioria curta
+
+    uint64_t empty[LOCK_HIST_BUCKETS] = {0};
+    failures += (lockHistogramQuantile(empty, 0.5) != 0);
+
+    pthread_barrier_destroy(&barrier);
+    profiledMutexDestroy(&lock);
+
+    if (failures == 0) {
+        printf("\nSUCESSO: perfil das travas consistente.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
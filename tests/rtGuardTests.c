@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "rtGuard.h"
+
+#define TOUCHED_PAGES 64
+
+// Evita que o compilador elimine pares malloc/free sem uso
+void* volatile sink;
+
+void allocate_and_free(void) {
+    sink = malloc(64);
+    free(sink);
+}
+
+int main() {
+    int failures = 0;
+    const char* names[] = {"aloca", "faltas"};
+
+    // === 1. TESTE: Contagem de alocações ===
+    printf("--- TESTE: ALOCACOES NA FASE DE TEMPO REAL ---\n");
+    setenv(RT_GUARD_ENV, "count", 1);
+    failures += rtGuardInit(names, 2) != RT_GUARD_COUNT;
+
+    allocate_and_free();   // fora da fase: não conta
+    rtGuardEnter(0);
+    rtGuardStepBegin(0);
+    allocate_and_free();
+    sink = calloc(4, 16);
+    sink = realloc(sink, 128);
+    free(sink);
+    rtGuardStepEnd();
+    rtGuardLeave();
+    allocate_and_free();   // fora da fase: não conta
+
+    const RtGuardTaskStats* st = rtGuardStats(0);
+    printf("Ativacoes: %ld | Alocacoes: %ld | Frees: %ld\n", st->activations, st->allocations, st->frees);
+    failures += (st->activations != 1) || (st->allocations != 3) || (st->frees != 2);
+
+    // === 2. TESTE: Faltas de página ===
+    printf("\n--- TESTE: FALTAS DE PAGINA POR ATIVACAO ---\n");
+    long page = sysconf(_SC_PAGESIZE);
+    char* region = mmap(NULL, TOUCHED_PAGES * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        printf("FALHA: mmap indisponivel.\n");
+        return 1;
+    }
+    rtGuardEnter(1);
+    rtGuardStepBegin(1);
+    for (int p = 0; p < TOUCHED_PAGES; p++) region[p * page] = 1;   // primeiro toque em cada página
+    rtGuardStepEnd();
+    rtGuardStepBegin(1);
+    for (int p = 0; p < TOUCHED_PAGES; p++) region[p * page] = 2;   // páginas já mapeadas
+    rtGuardStepEnd();
+    rtGuardLeave();
+    munmap(region, TOUCHED_PAGES * page);
+
+    st = rtGuardStats(1);
+    printf("Ativacoes: %ld | Faltas menores: %ld | Ativacoes com falta: %ld\n",
+           st->activations, st->minor_faults, st->faulting_activations);
+    failures += (st->activations != 2) || (st->minor_faults < TOUCHED_PAGES) || (st->faulting_activations != 1);
+    failures += (st->allocations != 0);
+
+    // === 3. TESTE: Modo trap ===
+    // O processo filho deve abortar na primeira alocação dentro da fase
+    printf("\n--- TESTE: MODO TRAP ---\n");
+    pid_t child = fork();
+    if (child == 0) {
+        setenv(RT_GUARD_ENV, "trap", 1);
+        rtGuardInit(names, 2);
+        rtGuardEnter(0);
+        allocate_and_free();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    int trapped = WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+    printf("Filho %s\n", trapped ? "abortado (SIGABRT)" : "terminou sem abortar");
+    failures += !trapped;
+
+    if (failures == 0) {
+        printf("\nSUCESSO: guarda de tempo real consistente.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
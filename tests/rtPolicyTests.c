@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include "rtPolicy.h"
+
+int main() {
+    int failures = 0;
+
+    // === 1. TESTE: Limite de Liu & Layland ===
+    printf("--- TESTE: LIMITE DE UTILIZACAO RMS ---\n");
+    for (int n = 1; n <= 7; n++) printf("n = %d: %.4f\n", n, rmsUtilizationBound(n));
+    failures += fabs(rmsUtilizationBound(1) - 1.0) > 1e-12;
+    failures += fabs(rmsUtilizationBound(2) - 2.0 * (sqrt(2.0) - 1.0)) > 1e-12;
+    failures += fabs(rmsUtilizationBound(1000) - log(2.0)) > 1e-3;   // tende a ln 2
+
+    // === 2. TESTE: Admissão ===
+    // U = 0.8 passa nos dois; U = 0.95 só no EDF (limite RMS para n = 2 é 0.828); U = 1.1 em nenhum
+    printf("\n--- TESTE: ADMISSAO ---\n");
+    int periods[] = {10, 20};
+    double light[] = {5.0, 6.0};    // U = 0.8
+    double heavy[] = {5.0, 9.0};    // U = 0.95
+    double over[] = {6.0, 10.0};    // U = 1.1
+    AdmissionResult r;
+
+    admissionTest(POLICY_FIFO, light, periods, 2, &r);
+    printf("U = %.3f, RMS: %s\n", r.utilization, r.admitted ? "admitido" : "recusado");
+    failures += !r.admitted || fabs(r.utilization - 0.8) > 1e-12;
+
+    admissionTest(POLICY_FIFO, heavy, periods, 2, &r);
+    printf("U = %.3f, RMS: %s\n", r.utilization, r.admitted ? "admitido" : "recusado");
+    failures += r.admitted;
+
+    admissionTest(POLICY_DEADLINE, heavy, periods, 2, &r);
+    printf("U = %.3f, EDF: %s\n", r.utilization, r.admitted ? "admitido" : "recusado");
+    failures += !r.admitted;
+
+    admissionTest(POLICY_DEADLINE, over, periods, 2, &r);
+    printf("U = %.3f, EDF: %s\n", r.utilization, r.admitted ? "admitido" : "recusado");
+    failures += r.admitted;
+
+    admissionTest(POLICY_OTHER, over, periods, 2, &r);
+    failures += !r.admitted;   // sem garantia, nada a recusar
+
+    // === 3. TESTE: Nomes ===
+    SchedPolicy policy;
+    failures += parsePolicy("deadline", &policy) != 0 || policy != POLICY_DEADLINE;
+    failures += parsePolicy("fifo", &policy) != 0 || policy != POLICY_FIFO;
+    failures += parsePolicy("rr", &policy) != -1;
+
+    // === 4. TESTE: Rebaixamento para other ===
+    // Uma thread já em fifo ou deadline precisa voltar de fato a SCHED_OTHER quando
+    // o conjunto é recusado (requer privilégio; sem ele o caso é pulado)
+    printf("\n--- TESTE: REBAIXAMENTO PARA OTHER ---\n");
+    SchedPolicy raised[] = {POLICY_FIFO, POLICY_DEADLINE};
+    for (int i = 0; i < 2; i++) {
+        if (applySchedPolicy(raised[i], 10, 1.0, 10) != 0) {
+            printf("%s: sem privilegio, pulado\n", policyName(raised[i]));
+            continue;
+        }
+        int before = sched_getscheduler(0);
+        SchedPolicy effective = applySchedPolicyWithFallback("teste", POLICY_OTHER, 0, 0.0, 0);
+        int after = sched_getscheduler(0);
+        printf("%s: politica do kernel %d -> %d\n", policyName(raised[i]), before, after);
+        failures += (before == SCHED_OTHER) || (after != SCHED_OTHER) || (effective != POLICY_OTHER);
+    }
+
+    if (failures == 0) {
+        printf("\nSUCESSO: testes de admissao consistentes.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
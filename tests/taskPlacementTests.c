@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <sched.h>
+#include <string.h>
+#include "taskPlacement.h"
+
+// Chaves aceitas na especificação usada pelos testes
+static const char* const known_keys[] = {"control", "linearization", "logger", "controle", "interface", NULL};
+
+// Confere se o conjunto contém exatamente as CPUs esperadas
+static int sameCpus(const cpu_set_t* set, const int* expected, int n) {
+    cpu_set_t want;
+    CPU_ZERO(&want);
+    for (int i = 0; i < n; i++) CPU_SET(expected[i], &want);
+    return CPU_EQUAL(set, &want);
+}
+
+int main() {
+    int failures = 0;
+    cpu_set_t set;
+
+    // === 1. TESTE: Listas de CPUs ===
+    printf("--- TESTE: LISTAS DE CPUS ---\n");
+    int single[] = {2};
+    int range[] = {0, 1, 2, 3};
+    int mixed[] = {0, 2, 3, 7};
+    failures += (parseCpuList("2", &set) != 0) || !sameCpus(&set, single, 1);
+    failures += (parseCpuList("0-3", &set) != 0) || !sameCpus(&set, range, 4);
+    failures += (parseCpuList("0,2-3,7", &set) != 0) || !sameCpus(&set, mixed, 4);
+    // Repetições e intervalos sobrepostos não duplicam CPUs
+    failures += (parseCpuList("1,1,0-2,2-3", &set) != 0) || !sameCpus(&set, range, 4) || (CPU_COUNT(&set) != 4);
+
+    char text[64];
+    parseCpuList("0,2-3,7", &set);
+    formatCpuList(&set, text, sizeof(text));
+    printf("\"0,2-3,7\" -> %s\n", text);
+    failures += (strcmp(text, "0,2-3,7") != 0);
+
+    // === 2. TESTE: CPUs Inválidas ===
+    printf("\n--- TESTE: CPUS INVALIDAS ---\n");
+    const char* invalid[] = {"", "x", "-1", "3-1", "1-", "0,,1", "0,", "1;2", "0-99999", NULL};
+    for (int i = 0; invalid[i] != NULL; i++) {
+        if (parseCpuList(invalid[i], &set) != -1) {
+            printf("FALHA: \"%s\" aceita\n", invalid[i]);
+            failures++;
+        }
+    }
+    failures += (parseCpuList(NULL, &set) != -1);
+    printf("Listas vazias, negativas, invertidas, incompletas e acima de CPU_SETSIZE rejeitadas.\n");
+
+    // === 3. TESTE: Precedência tarefa > grupo > all ===
+    printf("\n--- TESTE: PRECEDENCIA DA ESPECIFICACAO ---\n");
+    int cpu0[] = {0};
+    int cpu1[] = {1};
+    int cpu2[] = {2};
+    const char* specs[] = {"all=0;controle=1;control=2", "control=2;controle=1;all=0"};
+    for (int s = 0; s < 2; s++) {
+        TaskPlacement p;
+        failures += (resolvePlacement(specs[s], "control", "controle", known_keys, &p) != 0) || !p.pinned || !sameCpus(&p.cpus, cpu2, 1);
+        failures += (resolvePlacement(specs[s], "linearization", "controle", known_keys, &p) != 0) || !p.pinned || !sameCpus(&p.cpus, cpu1, 1);
+        failures += (resolvePlacement(specs[s], "logger", "interface", known_keys, &p) != 0) || !p.pinned || !sameCpus(&p.cpus, cpu0, 1);
+    }
+    printf("Tarefa, grupo e all resolvidos independentemente da ordem.\n");
+
+    TaskPlacement p;
+    failures += (resolvePlacement(NULL, "control", "controle", known_keys, &p) != 0) || p.pinned;
+    failures += (resolvePlacement("interface=0", "control", "controle", known_keys, &p) != 0) || p.pinned;
+    failures += (resolvePlacement("controle", "control", "controle", known_keys, &p) != -1);
+    failures += (resolvePlacement("controle=", "control", "controle", known_keys, &p) != -1);
+    failures += (resolvePlacement("control=2;all=x", "control", "controle", known_keys, &p) != -1);
+    failures += (resolvePlacement("contrl=3", "control", "controle", known_keys, &p) != -1);
+    failures += (resolvePlacement("control=2;interfce=0", "control", "controle", known_keys, &p) != -1);
+    printf("Sem casamento a tarefa fica livre; entradas malformadas e chaves desconhecidas rejeitadas.\n");
+
+    if (failures == 0) {
+        printf("\nSUCESSO: listas de CPUs e precedencia da afinidade corretas.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
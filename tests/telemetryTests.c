@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "telemetry.h"
+
+#define READS 200000
+#define COMMANDS 100000
+
+// O segmento é alocado na memória do processo: o teste não toca em /rtp_telemetry
+TelemetrySegment* segment;
+TaskStatsCell cell;
+atomic_int reader_done;   // os escritores publicam até o leitor terminar as suas leituras
+
+// Escritor: cada fotografia k tem todos os campos iguais a k
+void* snapshot_writer(void* arg) {
+    (void)arg;
+    TelemetrySnapshot snapshot = {0};
+    for (int k = 1; !atomic_load(&reader_done); k++) {
+        snapshot.t = k;
+        for (int i = 0; i < 3; i++) snapshot.x_state[i] = k;
+        snapshot.alpha1 = k;
+        snapshot.alpha2 = k;
+        snapshot.num_tasks = k;
+        telemetryPublish(segment, &snapshot);
+    }
+    return NULL;
+}
+
+// Escritor das estatísticas: toda ativação tem C = 1 ms e T(k) = 2 ms
+void* stats_writer(void* arg) {
+    (void)arg;
+    while (!atomic_load(&reader_done)) telemetryRecordActivation(&cell, 2.0, 1.0, 0.0, 0);
+    return NULL;
+}
+
+// Produtor do anel: comandos com valores 0, 1, 2, ...
+void* command_producer(void* arg) {
+    (void)arg;
+    for (int i = 0; i < COMMANDS; i++) {
+        TelemetryCommand cmd = {TELEMETRY_CMD_SET_ALPHA1, (double)i};
+        while (telemetrySendCommand(segment, &cmd) != 0) sched_yield();
+    }
+    return NULL;
+}
+
+int main() {
+    int failures = 0;
+    segment = (TelemetrySegment*)calloc(1, sizeof(TelemetrySegment));
+    if (segment == NULL) return 1;
+
+    // === 1. TESTE: Seqlock da Fotografia ===
+    printf("--- TESTE: SEQLOCK DA FOTOGRAFIA ---\n");
+    pthread_t writer;
+    pthread_create(&writer, NULL, snapshot_writer, NULL);
+    long reads = 0, torn = 0;
+    double last = 0.0;
+    for (int i = 0; i < READS; i++) {
+        TelemetrySnapshot s;
+        if (telemetryRead(segment, &s) != 0) continue;
+        reads++;
+        int consistent = (s.x_state[0] == s.t) && (s.x_state[2] == s.t) && (s.alpha1 == s.t) &&
+                         (s.alpha2 == s.t) && (s.num_tasks == (int)s.t);
+        torn += !consistent;
+        failures += (s.t < last);   // nunca volta no tempo
+        last = s.t;
+    }
+    atomic_store(&reader_done, 1);
+    pthread_join(writer, NULL);
+    printf("Leituras: %ld | Fotografias misturadas: %ld\n", reads, torn);
+    failures += (torn != 0) || (reads == 0);
+
+    // Ao final a sequência é par e vale duas vezes o número de publicações
+    TelemetrySnapshot final;
+    failures += (telemetryRead(segment, &final) != 0) || (2.0 * final.t != atomic_load(&segment->sequence));
+
+    // === 2. TESTE: Seqlock das Estatísticas por Tarefa ===
+    printf("\n--- TESTE: SEQLOCK DAS ESTATISTICAS ---\n");
+    cell.stats.period_ms = 2;
+    atomic_store(&reader_done, 0);
+    pthread_create(&writer, NULL, stats_writer, NULL);
+    reads = torn = 0;
+    for (int i = 0; i < READS; i++) {
+        TaskTimingStats st;
+        if (telemetryReadStats(&cell, &st) != 0) continue;
+        reads++;
+        // ativações e somas sempre da mesma ativação
+        torn += (st.sum_exec_ms != (double)st.activations) || (st.sum_period_ms != 2.0 * st.period_samples) ||
+                (st.period_samples != st.activations);
+    }
+    atomic_store(&reader_done, 1);
+    pthread_join(writer, NULL);
+    printf("Leituras: %ld | Copias misturadas: %ld | Ativacoes: %ld\n", reads, torn, cell.stats.activations);
+    failures += (torn != 0) || (reads == 0);
+    failures += (2u * cell.stats.activations != atomic_load(&cell.sequence));
+    failures += (cell.stats.max_jitter_ms != 0.0) || (cell.stats.misses != 0);
+
+    // === 3. TESTE: Anel de Comandos ===
+    printf("\n--- TESTE: ANEL DE COMANDOS ---\n");
+    TelemetryCommand cmd = {TELEMETRY_CMD_ADD_ALPHA2, 0.0};
+    failures += (telemetryPollCommand(segment, &cmd) != -1);   // vazio
+    for (int i = 0; i < TELEMETRY_CMD_CAPACITY; i++) {
+        cmd.value = i;
+        failures += (telemetrySendCommand(segment, &cmd) != 0);
+    }
+    failures += (telemetrySendCommand(segment, &cmd) != -1);   // cheio
+    for (int i = 0; i < TELEMETRY_CMD_CAPACITY; i++) {
+        failures += (telemetryPollCommand(segment, &cmd) != 0) || (cmd.value != i) || (cmd.type != TELEMETRY_CMD_ADD_ALPHA2);
+    }
+    failures += (telemetryPollCommand(segment, &cmd) != -1);
+    printf("Capacidade %d: cheio e vazio detectados, ordem FIFO preservada.\n", TELEMETRY_CMD_CAPACITY);
+
+    // Produtor e consumidor concorrentes, com vários giros do anel
+    pthread_t producer;
+    pthread_create(&producer, NULL, command_producer, NULL);
+    int received = 0, out_of_order = 0;
+    while (received < COMMANDS) {
+        if (telemetryPollCommand(segment, &cmd) != 0) {
+            sched_yield();
+            continue;
+        }
+        out_of_order += (cmd.value != received) || (cmd.type != TELEMETRY_CMD_SET_ALPHA1);
+        received++;
+    }
+    pthread_join(producer, NULL);
+    printf("Comandos recebidos: %d | Fora de ordem: %d\n", received, out_of_order);
+    failures += (out_of_order != 0) || (telemetryPollCommand(segment, &cmd) != -1);
+
+    free(segment);
+
+    if (failures == 0) {
+        printf("\nSUCESSO: seqlock e anel de comandos consistentes.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace.h"
+
+#define TRACE_PATH "/tmp/teste_trace.trc"
+
+// Grava o cabeçalho alterado de volta no arquivo
+int write_header(const TraceHeader* header) {
+    FILE* file = fopen(TRACE_PATH, "r+b");
+    if (file == NULL) return -1;
+    int status = (fwrite(header, sizeof(*header), 1, file) == 1) ? 0 : -1;
+    if (fclose(file) != 0) status = -1;
+    return status;
+}
+
+int main() {
+    int failures = 0;
+
+    // === 1. TESTE: Ida e Volta pelo Arquivo ===
+    printf("--- TESTE: GRAVACAO E LEITURA DO TRACE ---\n");
+    TraceRecorder* recorder = createTraceRecorder(8);
+    if (recorder == NULL) return 1;
+
+    double x[3] = {1.5, -2.25, 0.125};
+    double ref[2] = {3.0, 4.0};
+    double t = 0.03;
+    traceRecord(recorder, TRACE_SIG_ACTIVATION, 5, NULL, 0);
+    traceRecord(recorder, TRACE_SIG_X_STATE | TRACE_INPUT_FLAG, 5, x, 3);
+    traceRecord(recorder, TRACE_SIG_TIME, 5, &t, 1);
+    traceRecord(recorder, TRACE_SIG_REF, 0, ref, 5);   // count acima do máximo é truncado
+
+    failures += (saveTrace(recorder, TRACE_PATH) != 0);
+
+    size_t count = 0;
+    TraceRecord* records = loadTrace(TRACE_PATH, &count);
+    failures += (records == NULL) || (count != 4);
+    if (records != NULL && count == 4) {
+        for (size_t i = 0; i < count; i++) {
+            failures += (records[i].sequence != i);
+            failures += (i > 0 && records[i].timestamp_ns < records[i - 1].timestamp_ns);
+        }
+        failures += (records[0].signal != TRACE_SIG_ACTIVATION) || (records[0].count != 0) || (records[0].task != 5);
+        failures += (records[1].signal != (TRACE_SIG_X_STATE | TRACE_INPUT_FLAG)) || (records[1].count != 3);
+        failures += (memcmp(records[1].values, x, sizeof(x)) != 0);
+        failures += (records[2].signal != TRACE_SIG_TIME) || (records[2].count != 1) || (records[2].values[0] != t);
+        failures += (records[3].task != 0) || (records[3].count != TRACE_MAX_VALUES);
+        printf("Registros lidos: %zu | Entrada: sinal %d, tarefa %d, x = [%g, %g, %g]\n", count,
+               records[1].signal & ~TRACE_INPUT_FLAG, records[1].task,
+               records[1].values[0], records[1].values[1], records[1].values[2]);
+    }
+    free(records);
+
+    // === 2. TESTE: Buffer Cheio ===
+    printf("\n--- TESTE: BUFFER CHEIO ---\n");
+    for (int i = 0; i < 10; i++) traceRecord(recorder, TRACE_SIG_TIME, 5, &t, 1);
+    failures += (saveTrace(recorder, TRACE_PATH) != 0);
+
+    TraceHeader header;
+    FILE* file = fopen(TRACE_PATH, "rb");
+    failures += (file == NULL);
+    if (file != NULL) {
+        failures += (fread(&header, sizeof(header), 1, file) != 1);
+        fclose(file);
+        printf("Gravados: %llu | Perdidos: %llu\n", (unsigned long long)header.count,
+               (unsigned long long)header.dropped);
+        failures += (header.count != 8) || (header.dropped != 6);
+    }
+    records = loadTrace(TRACE_PATH, &count);
+    failures += (records == NULL) || (count != 8);
+    free(records);
+    freeTraceRecorder(recorder);
+
+    // === 3. TESTE: Cabeçalho Inválido ===
+    printf("\n--- TESTE: CABECALHO INVALIDO ---\n");
+    TraceHeader bad = header;
+    bad.magic = 0;
+    failures += (write_header(&bad) != 0) || (loadTrace(TRACE_PATH, &count) != NULL);
+
+    bad = header;
+    bad.version = TRACE_VERSION - 1;
+    failures += (write_header(&bad) != 0) || (loadTrace(TRACE_PATH, &count) != NULL);
+
+    bad = header;
+    bad.count = header.count + 1;   // arquivo truncado
+    failures += (write_header(&bad) != 0) || (loadTrace(TRACE_PATH, &count) != NULL);
+
+    bad = header;
+    bad.count = UINT64_MAX / sizeof(TraceRecord) + 2;   // count * sizeof estoura para um valor pequeno
+    failures += (write_header(&bad) != 0) || (loadTrace(TRACE_PATH, &count) != NULL);
+
+    failures += (loadTrace("/tmp/teste_trace_inexistente.trc", &count) != NULL);
+    printf("Magia, versao e tamanho divergentes rejeitados.\n");
+
+    // === 4. TESTE: Registros Inválidos ===
+    printf("\n--- TESTE: REGISTROS INVALIDOS ---\n");
+    failures += (write_header(&header) != 0) || (loadTrace(TRACE_PATH, &count) == NULL);
+    TraceRecord record;
+    FILE* corrupt = fopen(TRACE_PATH, "r+b");
+    failures += (corrupt == NULL);
+    if (corrupt != NULL) {
+        // count acima de TRACE_MAX_VALUES no último registro
+        failures += (fseek(corrupt, sizeof(header) + 7 * sizeof(TraceRecord), SEEK_SET) != 0) ||
+                    (fread(&record, sizeof(record), 1, corrupt) != 1);
+        record.count = 200;
+        failures += (fseek(corrupt, sizeof(header) + 7 * sizeof(TraceRecord), SEEK_SET) != 0) ||
+                    (fwrite(&record, sizeof(record), 1, corrupt) != 1) || (fflush(corrupt) != 0);
+        failures += (loadTrace(TRACE_PATH, &count) != NULL);
+
+        // sinal fora do intervalo, com e sem a marca de entrada
+        record.count = 1;
+        record.signal = TRACE_NUM_SIGNALS | TRACE_INPUT_FLAG;
+        failures += (fseek(corrupt, sizeof(header) + 7 * sizeof(TraceRecord), SEEK_SET) != 0) ||
+                    (fwrite(&record, sizeof(record), 1, corrupt) != 1) || (fflush(corrupt) != 0);
+        failures += (loadTrace(TRACE_PATH, &count) != NULL);
+        fclose(corrupt);
+    }
+    printf("Registros com count ou sinal fora do intervalo rejeitados.\n");
+    unlink(TRACE_PATH);
+
+    if (failures == 0) {
+        printf("\nSUCESSO: formato do trace preservado na ida e volta.\n");
+    } else {
+        printf("\nFALHA: %d verificacoes divergiram.\n", failures);
+    }
+    return failures ? 1 : 0;
+}